@@ -456,6 +456,36 @@ void drawGamefield(uint8_t quadrant, uint8_t *field) {
     }
 }
 
+void drawGamefieldCells(uint8_t quadrant, uint8_t *gamefield, uint8_t *cells, uint8_t count) {
+    uint16_t pos;
+    uint8_t baseX;
+    uint8_t baseY;
+    uint8_t i, x, y;
+    uint8_t actualX;
+
+    pos = fieldX + quadrantOffset[quadrant];
+    baseX = (uint8_t)(pos % WIDTH);  // WIDTH = 40
+    baseY = (uint8_t)(pos / WIDTH);  // WIDTH = 40
+
+    while (count--) {
+        i = *cells++;
+        if (!gamefield[i])
+            continue;
+
+        y = i / 10;
+        x = i - y * 10;
+        actualX = baseX + x;
+
+        if (gamefield[i] == FIELD_ATTACK) {
+            hires_putc(actualX, baseY + y * 8, ROP_CPY, (actualX % 2) ? HIT_NORMAL_ODD : HIT_NORMAL_EVEN);
+            patchFieldHitLeftSea(actualX, (uint8_t)(baseY + y * 8),
+                                 (uint8_t)(x > 0 && gamefield[i - 1] == 0));
+        } else {
+            hires_putc(actualX, baseY + y * 8, ROP_CPY, (actualX % 2) ? MISS_NORMAL_ODD : MISS_NORMAL_EVEN);
+        }
+    }
+}
+
 void drawGamefieldUpdate(uint8_t quadrant, uint8_t *gamefield, uint8_t attackPos, uint8_t anim) {
     uint16_t pos;
     uint8_t baseX;
@@ -38,3 +38,15 @@ uint8_t getRandomNumber(uint8_t maxExclusive) {
     seed = seed * 1103515245 + 12345;
     return (uint8_t)(seed % maxExclusive);
 }
+
+void initTransferSpeed() {
+    ;
+}
+
+void fallbackTransferSpeed() {
+    ;
+}
+
+uint8_t getTransferKbps() {
+    return 0;
+}
@@ -20,11 +20,12 @@ extern unsigned char charset[];
 // Bottom line, program+vars needs to stay below $9A1F
 
 #define CHARSET_LOC 0xB000
-#define SCREEN_LOC ((uint8_t *)0xB400)
-#define SCREEN_BAK 0xAB00
+#define INGAME_CHARSET_LOC 0xA000 // Over the unused missile area (see initGraphics)
+#define SCREEN_PAGE0 0xB400
+#define SCREEN_PAGE1 0xAB00 // Back page (see drawPage)
 #define PM_BASE 0xA000
 
-#define xypos(x, y) (SCREEN_LOC + x + (y) * WIDTH)
+#define xypos(x, y) (screen + x + (y) * WIDTH)
 
 #define TILE_SEA 0x38
 #define TILE_MISS 0xE1
@@ -34,6 +35,11 @@ extern unsigned char charset[];
 
 static uint8_t colorMode = 0, oldChbas = 0, colIndex = 0, fieldX = 0, playerCount, box_color = 0xff;
 static bool inGameCharSet = false;
+
+// Page being drawn, and whether each page shows the board (in-game charset)
+static uint8_t *screen = (uint8_t *)SCREEN_PAGE0;
+static uint8_t drawnPage = 0, shownPage = 0;
+static bool pageInGame[2];
 static uint16_t lastCursor[] = {0, PM_BASE + 1024, PM_BASE + 1024, PM_BASE + 1024};
 
 static uint16_t quadrant_offset[] = {
@@ -41,13 +47,16 @@ static uint16_t quadrant_offset[] = {
     WIDTH * 2 + 8,
     WIDTH * 2 + 21,
     WIDTH * 14 + 21};
+
+// Screen offset of each gamefield row
+static uint16_t fieldRowOffset[] = {0, WIDTH, WIDTH * 2, WIDTH * 3, WIDTH * 4, WIDTH * 5, WIDTH * 6, WIDTH * 7, WIDTH * 8, WIDTH * 9};
 uint8_t legendShipOffset[] = {2, 1, 0, 40 * 5, 40 * 6 + 1};
 
 // 26 lines
 void DisplayList =
     {
         DL_BLK8, DL_BLK8,                                                     // 2 Blanks Lines
-        DL_LMS(DL_CHR40x8x4), SCREEN_LOC,                                     // 1 Line
+        DL_LMS(DL_CHR40x8x4), SCREEN_PAGE0,                                   // 1 Line
         DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, // 5 Lines
         DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, // 5 Lines
         DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, DL_CHR40x8x4, // 5 Lines
@@ -77,6 +86,9 @@ const uint8_t cursor_pmg[] = {
 // Defined in this file
 void drawTextAdd(uint8_t *dest, const char *s, uint8_t add);
 void drawShipInternal(uint8_t *dest, uint8_t size, uint8_t delta);
+void buildInGameCharSet();
+void useInGameCharSet();
+void useNormalCharSet();
 
 unsigned char cycleNextColor()
 {
@@ -114,16 +126,20 @@ void initGraphics()
     oldChbas = OS.chbas;
     OS.chbas = CHARSET_LOC / 256;
 
-    // Initialize player+missle graphics, single line
-    OS.sdmctl = OS.sdmctl | (12 + 16);
+    // Build the in-game charset once. Boards switch to it through chbas
+    buildInGameCharSet();
+
+    // Initialize player graphics, single line. Missiles are not used, so
+    // their memory holds the in-game charset
+    OS.sdmctl = OS.sdmctl & ~4 | (8 + 16);
 
     OS.gprior = 1; // PM graphics above playfield
 
     POKE(0xD407, PM_BASE / 256);
 
     // PM
-    // Turn on P+M
-    POKE(0xD01D, 3);
+    // Turn on players only
+    POKE(0xD01D, 2);
 
     // PAL colors
     if (PEEK(0xD014) == 1)
@@ -137,14 +153,37 @@ void initGraphics()
 
 bool saveScreenBuffer()
 {
-    return false;
-    // memcpy(SCREEN_BAK, SCREEN_LOC, WIDTH * HEIGHT);
+    // Draw on the other page, leaving the one shown as is (see drawPage)
+    drawPage(state.page ^ 1);
+    return true;
 }
 
 void restoreScreenBuffer()
 {
-    // waitvsync();
-    // memcpy(SCREEN_LOC, SCREEN_BAK, WIDTH * HEIGHT);
+    drawPage(state.page);
+    showPage(state.page);
+}
+
+void drawPage(uint8_t page)
+{
+    drawnPage = page;
+    screen = (uint8_t *)(page ? SCREEN_PAGE1 : SCREEN_PAGE0);
+}
+
+void showPage(uint8_t page)
+{
+    shownPage = page;
+
+    // The charset takes effect at vsync, along with the new page
+    if (pageInGame[page])
+        useInGameCharSet();
+    else
+        useNormalCharSet();
+
+    waitvsync();
+
+    // Point the first mode line of the display list at the page
+    POKEW(PEEKW(0x230) + 3, page ? SCREEN_PAGE1 : SCREEN_PAGE0);
 }
 
 void drawText(unsigned char x, unsigned char y, const char *s)
@@ -177,7 +216,7 @@ void drawTextAlt(unsigned char x, unsigned char y, const char *s)
         if (c > 90 || (c < 65 && c >= 32))
         {
             // Use alternate numbers if showing the clock
-            if (inGameCharSet && y == HEIGHT - 1 && c >= 0x30 && c <= 0x39)
+            if (pageInGame[drawnPage] && y == HEIGHT - 1 && c >= 0x30 && c <= 0x39)
                 c += 0x60;
             c += 96;
         }
@@ -189,16 +228,22 @@ void drawTextAlt(unsigned char x, unsigned char y, const char *s)
 void resetScreen()
 {
     waitvsync();
-    memset((void *)SCREEN_LOC, 0, WIDTH * HEIGHT);
-    if (inGameCharSet)
-    {
-        // Restore normal charset
-        memcpy((void *)CHARSET_LOC, &charset, 1024);
-        inGameCharSet = false;
+    memset((void *)screen, 0, WIDTH * HEIGHT);
+    pageInGame[drawnPage] = false;
+    if (drawnPage == shownPage)
+        useNormalCharSet();
+}
 
-        // Clear any cursors
-        memset(PM_BASE + 1024, 0, 768);
-    }
+void useNormalCharSet()
+{
+    if (!inGameCharSet)
+        return;
+
+    OS.chbas = CHARSET_LOC / 256;
+    inGameCharSet = false;
+
+    // Clear any cursors
+    memset(PM_BASE + 1024, 0, 768);
 }
 
 void drawIcon(unsigned char x, unsigned char y, unsigned char icon)
@@ -243,7 +288,7 @@ void drawTextAdd(uint8_t *dest, const char *s, uint8_t add)
 void drawPlayerName(uint8_t player, const char *name, bool active)
 {
     static uint8_t i, add;
-    uint8_t *dest = SCREEN_LOC + fieldX + quadrant_offset[player] - WIDTH - 1;
+    uint8_t *dest = screen + fieldX + quadrant_offset[player] - WIDTH - 1;
     add = active ? 0 : 128;
 
     // Draw top and bottom borders and name label
@@ -348,6 +393,31 @@ void drawPlayerName(uint8_t player, const char *name, bool active)
     }
 }
 
+void buildInGameCharSet()
+{
+    static uint8_t *dest;
+
+    memcpy((void *)INGAME_CHARSET_LOC, &charset, 1024);
+
+    // Invert 0-9 & A-Z characters for in-game charset
+    dest = INGAME_CHARSET_LOC + 0x01 * 8;
+    while (dest < INGAME_CHARSET_LOC + 0x5b * 8)
+    {
+        *dest = *dest ^ 0xff | 0b01010101;
+        dest++;
+        if (dest == INGAME_CHARSET_LOC + 0x1A * 8)
+            dest = INGAME_CHARSET_LOC + 0x40 * 8;
+        if (dest == INGAME_CHARSET_LOC + 0x02 * 8)
+            dest = INGAME_CHARSET_LOC + 0x10 * 8;
+    }
+}
+
+void useInGameCharSet()
+{
+    OS.chbas = INGAME_CHARSET_LOC / 256;
+    inGameCharSet = true;
+}
+
 void drawBoard(uint8_t currentPlayerCount)
 {
     static uint8_t i, y;
@@ -355,26 +425,16 @@ void drawBoard(uint8_t currentPlayerCount)
     playerCount = currentPlayerCount;
     fieldX = playerCount > 2 ? 0 : 7;
 
-    if (playerCount > 1 && !inGameCharSet)
+    if (playerCount > 1)
     {
-        // Invert 0-9 & A-Z characters for in-game charset
-        inGameCharSet = true;
-
-        dest = CHARSET_LOC + 0x01 * 8;
-        while (dest < CHARSET_LOC + 0x5b * 8)
-        {
-            *dest = *dest ^ 0xff | 0b01010101;
-            dest++;
-            if (dest == CHARSET_LOC + 0x1A * 8)
-                dest = CHARSET_LOC + 0x40 * 8;
-            if (dest == CHARSET_LOC + 0x02 * 8)
-                dest = CHARSET_LOC + 0x10 * 8;
-        }
+        pageInGame[drawnPage] = true;
+        if (drawnPage == shownPage)
+            useInGameCharSet();
     }
 
     for (i = 0; i < playerCount; i++)
     {
-        dest = SCREEN_LOC + fieldX + quadrant_offset[i];
+        dest = screen + fieldX + quadrant_offset[i];
 
         // Draw player border
         drawPlayerName(i, "", false);
@@ -466,7 +526,7 @@ void drawShip(uint8_t quadrant, uint8_t size, uint8_t pos, bool hide)
 void drawLegendShip(uint8_t player, uint8_t index, uint8_t size, uint8_t status)
 {
     static uint8_t i;
-    uint8_t *dest = SCREEN_LOC + fieldX + quadrant_offset[player] + legendShipOffset[index];
+    uint8_t *dest = screen + fieldX + quadrant_offset[player] + legendShipOffset[index];
 
     if (player > 1 || (player > 0 && fieldX > 0))
     {
@@ -491,7 +551,7 @@ void drawLegendShip(uint8_t player, uint8_t index, uint8_t size, uint8_t status)
 void drawGamefield(uint8_t quadrant, uint8_t *field)
 {
     static uint8_t y, x;
-    uint8_t *dest = SCREEN_LOC + quadrant_offset[quadrant] + fieldX;
+    uint8_t *dest = screen + quadrant_offset[quadrant] + fieldX;
 
     for (y = 0; y < 10; ++y)
     {
@@ -510,9 +570,32 @@ void drawGamefield(uint8_t quadrant, uint8_t *field)
 }
 
 static bool cursorVisible = false;
+void drawGamefieldCells(uint8_t quadrant, uint8_t *gamefield, uint8_t *cells, uint8_t count)
+{
+    static uint8_t pos, y, c;
+    uint8_t *base = screen + quadrant_offset[quadrant] + fieldX;
+
+    if (cursorVisible)
+    {
+        cursorVisible = false;
+        memset(PM_BASE + 1024, 0, 768);
+    }
+
+    while (count--)
+    {
+        pos = *cells++;
+        c = gamefield[pos];
+        if (c)
+        {
+            y = pos / 10;
+            base[fieldRowOffset[y] + pos - y * 10] = c == FIELD_ATTACK ? TILE_HIT : TILE_MISS;
+        }
+    }
+}
+
 void drawGamefieldUpdate(uint8_t quadrant, uint8_t *gamefield, uint8_t attackPos, uint8_t anim)
 {
-    uint8_t *dest = SCREEN_LOC + quadrant_offset[quadrant] + fieldX + (uint16_t)(attackPos / 10) * WIDTH + (attackPos % 10);
+    uint8_t *dest = screen + quadrant_offset[quadrant] + fieldX + (uint16_t)(attackPos / 10) * WIDTH + (attackPos % 10);
     uint8_t c = gamefield[attackPos];
 
     if (cursorVisible)
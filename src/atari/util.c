@@ -6,6 +6,14 @@
 #include "../fujinet-fuji.h"
 #include "../platform-specific/graphics.h"
 
+// SIO index for the standard 19200 baud
+#define HSIO_STANDARD 40
+
+// SIOV, and where it jumps in the stock XL/XE and 400/800 (OS-B) ROMs
+#define SIOV 0xE459
+#define SIOV_STOCK_XL 0xC933
+#define SIOV_STOCK_B 0xE971
+
 void resetTimer()
 {
     POKEW(0x13, 0);
@@ -16,8 +24,13 @@ uint16_t getTime()
     return PEEK(0x13) * 256 + PEEK(0x14);
 }
 
+// FujiNet high speed SIO index in use, and the one it had at startup
+static uint8_t hsioIndex = HSIO_STANDARD, hsioDefault = HSIO_STANDARD;
+static bool hsioSet;
+
 void quit()
 {
+    fuji_set_hsio_index(false, hsioDefault);
     resetScreen(false);
     resetGraphics();
     fuji_set_boot_config(1);
@@ -38,4 +51,43 @@ uint8_t getJiffiesPerSecond()
 uint8_t getRandomNumber(uint8_t maxExclusive)
 {
     return (*(uint8_t *)0xD20A) % maxExclusive;
-}
\ No newline at end of file
+}
+
+/// @brief Returns true if SIOV leads to a high speed SIO handler rather than the stock OS one
+bool hasHsioHandler()
+{
+    return PEEK(SIOV) == 0x4C && PEEKW(SIOV + 1) != SIOV_STOCK_XL && PEEKW(SIOV + 1) != SIOV_STOCK_B;
+}
+
+void initTransferSpeed()
+{
+    // Ask for a faster index than the FujiNet's own. Not saved, so it is restored on reboot.
+    // The stock OS handler always talks at 19200, so only ask when a high speed one is present
+    if (!fuji_get_hsio_index(&hsioDefault))
+        hsioDefault = HSIO_STANDARD;
+
+    hsioIndex = hsioDefault;
+    hsioSet = hsioDefault > HSIO_INDEX && hasHsioHandler() && fuji_set_hsio_index(false, HSIO_INDEX);
+    if (hsioSet)
+        hsioIndex = HSIO_INDEX;
+}
+
+void fallbackTransferSpeed()
+{
+    static uint8_t index;
+
+    // Step back towards the FujiNet's own index after transfer errors (e.g. checksum errors)
+    if (hsioIndex >= hsioDefault)
+        return;
+
+    index = hsioIndex + HSIO_STEP < hsioDefault ? hsioIndex + HSIO_STEP : hsioDefault;
+    if (fuji_set_hsio_index(false, index))
+        hsioIndex = index;
+}
+
+uint8_t getTransferKbps()
+{
+    // SIO clock / (2 * (index + 7)), in kbps. Only an index set by initTransferSpeed with a
+    // high speed handler present is known to be in use, otherwise it is the standard 19200 baud
+    return (uint8_t)((getJiffiesPerSecond() == 50 ? 887 : 895) / ((hsioSet ? hsioIndex : HSIO_STANDARD) + 7));
+}
@@ -7,6 +7,7 @@
 
 #define WIDTH 40
 #define HEIGHT 26
+#define PAGE_FLIP // Two screen pages (see drawPage)
 
 // Other platform specific constnats
 
@@ -22,6 +23,11 @@
 #define TIMER_NUM_OFFSET_X 0
 #define TIMER_NUM_OFFSET_Y 0
 
+// High speed SIO. Start at HSIO_INDEX (lower is faster) and step back towards the
+// FujiNet's own index by HSIO_STEP on transfer errors
+#define HSIO_INDEX 1
+#define HSIO_STEP 3
+
 // Icons
 #define ICON_TEXT_CURSOR 0x3A
 #define ICON_MARK 0x2B
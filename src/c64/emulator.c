@@ -61,47 +61,51 @@ appkeyC64 appkey;
 
 #ifdef CUSTOM_FUJINET_CALLS 
 
+// Bridge handshake (see support/c64/fuji_mock_network.py). The request is written to
+// vice-out as a sequence byte followed by the url. The bridge replies in vice-in with
+// the same sequence byte followed by the payload, so a stale reply is never taken for a new one
+#define BRIDGE_TIMEOUT 900 // Frames (15 seconds)
+
+static uint8_t bridgeSeq;
+
 int16_t custom_network_call(char *url, uint8_t *buffer, uint16_t max_len)
 {
+    static uint8_t seq;
+    static uint16_t wait;
     int16_t count;
-    int8_t  i, wait;
 
-    // Delete existing file
-    cbm_open(15,11,15, "s:vice-in"); 
+    // Skip 0, so a reply is never mistaken for an empty file
+    if (!++bridgeSeq)
+        bridgeSeq = 1;
 
-    // Write command file (currently just the url )
-    cbm_open(N_LFN,11,1,"vice-out"); 
-    cbm_write(N_LFN, url, strlen(url)); 
-    cbm_close(N_LFN);
+    // Delete the last reply and any request the bridge has not picked up
+    cbm_open(15,11,15, "s:vice-in");
+    cbm_close(15);
+    cbm_open(15,11,15, "s:vice-out");
+    cbm_close(15);
 
-    // Wait until command file no longer exists (signifies a response is ready) */
-    buffer[0]=0; 
-    wait=0; 
-    count = 1;
-    while (count != 0 ) {
+    // Write command file (sequence byte and url)
+    cbm_open(N_LFN,11,1,"vice-out");
+    cbm_write(N_LFN, &bridgeSeq, 1);
+    cbm_write(N_LFN, url, strlen(url));
+    cbm_close(N_LFN);
 
-        // If we timed out (>15 seconds), return false 
-        wait++; 
-        if (wait > 90) {
-        return 0;
+    // Wait for a reply carrying this sequence byte
+    buffer[0]=0;
+    for (wait = 0; wait < BRIDGE_TIMEOUT; wait++) {
+        waitvsync();
+
+        seq = 0;
+        cbm_open(N_LFN,11,0,"vice-in");
+        if (cbm_read(N_LFN, &seq, 1) == 1 && seq == bridgeSeq) {
+            count = cbm_read(N_LFN, buffer, max_len);
+            cbm_close(N_LFN);
+            return count < 0 ? 0 : count;
         }
+        cbm_close(N_LFN);
+    }
 
-        // Short delay
-        for (i=0;i<10;i++) { 
-        waitvsync(); 
-        } 
-
-        // Check if file exists by renaming it
-        count = cbm_open(15,11,15, "r0:vice-out=vice-out"); 
-        cbm_close(15); 
-    } 
-
-    // Read the response into the buffer 
-    cbm_open(N_LFN,11,0,"vice-in"); 
-    count = cbm_read(N_LFN,buffer, max_len); 
-    cbm_close(N_LFN); 
-
-    return count;
+    return 0;
 }
 
 unsigned char open_appkey(unsigned char open_mode, unsigned int creator_id, unsigned char app_id, char key_id)
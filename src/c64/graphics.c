@@ -8,13 +8,15 @@
 
 extern unsigned char charset[];
 extern void irqVsyncWait(void);
+extern void showColors(void);
 
-#define SCREEN_LOC ((uint8_t *)0xCC00)
-#define COLOR_LOC ((uint8_t *)0xD800)
+#define SCREEN_PAGE0 0xCC00
+#define SCREEN_PAGE1 0xC800 // Back page, in the free 1K between the charset and page 0
+#define COLOR_RAM ((uint8_t *)0xD800)
 #define CHARSET_LOC 0xC000
 
-#define xypos(x, y) (SCREEN_LOC + x + (y) * WIDTH)
-#define colorpos(x, y) (COLOR_LOC + x + (y) * WIDTH)
+#define xypos(x, y) (screen + x + (y) * WIDTH)
+#define colorpos(x, y) (colors + x + (y) * WIDTH)
 
 // These started at 0x00
 #define TOP_BORDER_START 0x25
@@ -86,7 +88,7 @@ extern void irqVsyncWait(void);
 #define CIA2_VIDEO_BANK_REGISTER 0xDD00
 
 // Sprite registers
-#define SPRITE_BASE 0x0340         // Sprite pointers in screen RAM
+#define SPRITE_POINTERS 0x3F8      // Sprite pointers, right after each screen page
 #define SPRITE_X_REG 0xD000        // Sprite 0 X position
 #define SPRITE_Y_REG 0xD001        // Sprite 0 Y position
 #define SPRITE_ENABLE_REG 0xD015   // Sprite enable register
@@ -95,6 +97,13 @@ extern void irqVsyncWait(void);
 
 static uint8_t fieldX = 0, playerCount = 0;
 
+// Page being drawn (see drawPage). Color RAM holds the colors of the page shown,
+// and colorBak those of the other page (copied in by showColors in colors.s)
+static uint8_t *screen = (uint8_t *)SCREEN_PAGE0, *colors = COLOR_RAM;
+static uint8_t drawnPage = 0, shownPage = 0;
+uint8_t colorBak[1000];
+static uint8_t colorSave[1000];
+
 // State for VIC bank switching to use RAM charset at CHARSET_LOC ($1000)
 static uint8_t _saved_d018 = 0;
 static uint8_t _saved_dd00 = 0;
@@ -121,6 +130,9 @@ static uint16_t quadrant_offset[] = {
     WIDTH * 2 + 21,
     WIDTH * 14 + 21};
 
+// Screen offset of each gamefield row
+static uint16_t fieldRowOffset[] = {0, WIDTH, WIDTH * 2, WIDTH * 3, WIDTH * 4, WIDTH * 5, WIDTH * 6, WIDTH * 7, WIDTH * 8, WIDTH * 9};
+
 uint8_t legendShipOffset[] = {2, 1, 0, 40 * 5, 40 * 6 + 1};
 
 // Defined in this file
@@ -174,16 +186,18 @@ void initGraphics()
     _saved_d016 = PEEK(0xD016);
     POKE(0xD016, PEEK(0xD016) | 0x10);    
     // Clear screen memory
-    memset(SCREEN_LOC, TILE_SEA, 1000);
+    memset(screen, TILE_SEA, 1000);
     
     // Set all character colors to text color
-    memset(COLOR_LOC, COLOR_TEXT, 1000);
+    memset(colors, COLOR_TEXT, 1000);
     
     // Initialize sprite data in charset area
     memcpy((void *)(SPRITE_DATA_LOC + 0x380), &cursorSprite, sizeof(cursorSprite));
     
-    // Set sprite pointer (sprite 0 uses location 0x380/64 = pointer value 14)
-    POKE(SPRITE_BASE, 14);
+    // Set sprite pointer (sprite 0 uses location 0x380/64 = pointer value 14).
+    // The VIC reads it after the screen shown, so both pages get it
+    POKE(SCREEN_PAGE0 + SPRITE_POINTERS, 14);
+    POKE(SCREEN_PAGE1 + SPRITE_POINTERS, 14);
     
     // Set sprite 0 color to white (cursor color)
     POKE(SPRITE_COLOR_REG, COLOR_CURSOR);
@@ -204,16 +218,46 @@ void resetGraphics()
     POKE(VIC_MEMORY_SETUP_REGISTER, _saved_d018);
     POKE(CIA2_VIDEO_BANK_REGISTER, _saved_dd00);
     POKE(0xD016, _saved_d016);
-    memset(SCREEN_LOC, TILE_SEA, 1000);
+    memset(screen, TILE_SEA, 1000);
 }
 
 bool saveScreenBuffer()
 {
-    return false;
+    // Draw on the other page, leaving the one shown as is (see drawPage)
+    drawPage(state.page ^ 1);
+    return true;
 }
 
 void restoreScreenBuffer()
 {
+    drawPage(state.page);
+    showPage(state.page);
+}
+
+void drawPage(uint8_t page)
+{
+    drawnPage = page;
+    screen = (uint8_t *)(page ? SCREEN_PAGE1 : SCREEN_PAGE0);
+    colors = page == shownPage ? COLOR_RAM : colorBak;
+}
+
+void showPage(uint8_t page)
+{
+    if (page == shownPage)
+        return;
+
+    // Color RAM does not move with the screen. Keep the colors of the page shown,
+    // then copy in those of the new page ahead of the raster
+    memcpy(colorSave, COLOR_RAM, 1000);
+
+    waitvsync();
+    POKE(VIC_MEMORY_SETUP_REGISTER, page ? 0x20 : 0x30);
+    showColors();
+
+    memcpy(colorBak, colorSave, 1000);
+
+    shownPage = page;
+    colors = drawnPage == shownPage ? COLOR_RAM : colorBak;
 }
 
 void drawText(unsigned char x, unsigned char y, const char *s)
@@ -260,8 +304,8 @@ void drawTextAlt(unsigned char x, unsigned char y, const char *s)
 
 void resetScreen()
 {
-    memset(SCREEN_LOC, TILE_SEA, 1000);
-    memset(COLOR_LOC, COLOR_TEXT, 1000);
+    memset(screen, TILE_SEA, 1000);
+    memset(colors, COLOR_TEXT, 1000);
 }
 
 void drawIcon(unsigned char x, unsigned char y, unsigned char icon)
@@ -297,7 +341,7 @@ void drawConnectionIcon(bool show)
 
 void drawTextAdd(uint8_t *dest, const char *s, uint8_t add)
 {
-    uint8_t *col_dest = COLOR_LOC + (dest - SCREEN_LOC);
+    uint8_t *col_dest = colors + (dest - screen);
     char c;
 
     while ((c = *s++))
@@ -312,7 +356,7 @@ void drawTextAdd(uint8_t *dest, const char *s, uint8_t add)
 void drawPlayerName(uint8_t player, const char *name, bool active)
 {
     static uint8_t i, add;
-    uint8_t *dest = SCREEN_LOC + fieldX + quadrant_offset[player] - WIDTH - 1;
+    uint8_t *dest = screen + fieldX + quadrant_offset[player] - WIDTH - 1;
     add = active ? 0 : 128;
 
     // Draw top and bottom borders and name label
@@ -443,7 +487,7 @@ void drawBoard(uint8_t currentPlayerCount)
 
     for (i = 0; i < playerCount; i++)
     {
-        dest = SCREEN_LOC + fieldX + quadrant_offset[i];
+        dest = screen + fieldX + quadrant_offset[i];
 
         // Draw player border
         drawPlayerName(i, "", false);
@@ -535,7 +579,7 @@ void drawShip(uint8_t quadrant, uint8_t size, uint8_t pos, bool hide)
 void drawLegendShip(uint8_t player, uint8_t index, uint8_t size, uint8_t status)
 {
     static uint8_t i;
-    uint8_t *dest = SCREEN_LOC + fieldX + quadrant_offset[player] + legendShipOffset[index];
+    uint8_t *dest = screen + fieldX + quadrant_offset[player] + legendShipOffset[index];
 
     if (player > 1 || (player > 0 && fieldX > 0))
     {
@@ -560,7 +604,7 @@ void drawLegendShip(uint8_t player, uint8_t index, uint8_t size, uint8_t status)
 void drawGamefield(uint8_t quadrant, uint8_t *field)
 {
     static uint8_t y, x;
-    uint8_t *dest = SCREEN_LOC + quadrant_offset[quadrant] + fieldX;
+    uint8_t *dest = screen + quadrant_offset[quadrant] + fieldX;
 
     for (y = 0; y < 10; ++y)
     {
@@ -578,9 +622,33 @@ void drawGamefield(uint8_t quadrant, uint8_t *field)
     }
 }
 
+void drawGamefieldCells(uint8_t quadrant, uint8_t *gamefield, uint8_t *cells, uint8_t count)
+{
+    static uint8_t pos, y, c;
+    uint8_t *base = screen + quadrant_offset[quadrant] + fieldX;
+
+    if (cursorVisible)
+    {
+        cursorVisible = false;
+        // Hide sprite 0
+        POKE(SPRITE_ENABLE_REG, PEEK(SPRITE_ENABLE_REG) & 0xFE);
+    }
+
+    while (count--)
+    {
+        pos = *cells++;
+        c = gamefield[pos];
+        if (c)
+        {
+            y = pos / 10;
+            base[fieldRowOffset[y] + pos - y * 10] = c == FIELD_ATTACK ? TILE_HIT : TILE_MISS;
+        }
+    }
+}
+
 void drawGamefieldUpdate(uint8_t quadrant, uint8_t *gamefield, uint8_t attackPos, uint8_t anim)
 {
-    uint8_t *dest = SCREEN_LOC + quadrant_offset[quadrant] + fieldX + (uint16_t)(attackPos / 10) * WIDTH + (attackPos % 10);
+    uint8_t *dest = screen + quadrant_offset[quadrant] + fieldX + (uint16_t)(attackPos / 10) * WIDTH + (attackPos % 10);
     uint8_t c = gamefield[attackPos];
 
     if (cursorVisible)
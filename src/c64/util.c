@@ -89,3 +89,17 @@ uint8_t getRandomNumber(uint8_t maxExclusive)
 
     // return (uint8_t)(mixed % maxExclusive);
 }
+
+void initTransferSpeed()
+{
+    // Not supported on C64
+}
+
+void fallbackTransferSpeed()
+{
+}
+
+uint8_t getTransferKbps()
+{
+    return 0;
+}
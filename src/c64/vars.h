@@ -5,6 +5,8 @@
 
 #define WIDTH 40
 #define HEIGHT 25
+#define PAGE_FLIP // Two screen pages (see drawPage)
+#define NO_FRAME_TIME // getTime reads a free running CIA timer, not frames (see telemetry.h)
 
 // Other platform specific constants
 
@@ -31,8 +33,10 @@
 #define ICON_CURSOR_BLIP 0x3E
 
 // to enable: make c64 -DUSE_EMULATOR
+// The emulator build is tested against support/server/standin.py, so it also asks for compact states
 #ifdef USE_EMULATOR
 #define CUSTOM_FUJINET_CALLS
+#define COMPACT_STATE
 #endif
 
 /**
@@ -18,6 +18,8 @@ uint8_t playerCount;
 //
 // Task 1 is swapped in whenever drawing graphics, and swapped out so
 // normal IO/FujiNet operations can occur.
+//
+// The back page (see drawPage) is in MMU blocks 48-51, shown with $FF9D = $C000.
 static const byte task1MMUBlocks[8] =
     {
         56,
@@ -30,6 +32,8 @@ static const byte task1MMUBlocks[8] =
         55, // Graphics blocks
 };
 
+static uint8_t drawnPage = 0;
+
 byte palette[] =
     {
         // RGB
@@ -93,11 +97,8 @@ byte waterAnim[] = {
 byte paletteBackup[16];
 #endif
 
-#define OFFSET_Y 2
-
 #ifdef COCO3
 #define CHAR_SIZE 32
-#define ROP_CPY 0xffff
 #define ROP_ALT 0x8888
 #define ROP_LINE 0xCC
 #define ROP_BLUE 0x7777
@@ -130,7 +131,6 @@ byte paletteBackup[16];
 #define FIELDX_1V1 7
 #else
 #define CHAR_SIZE 8
-#define ROP_CPY 0xff
 #define ROP_ALT 0b10101010
 #define ROP_LINE 0b10101010
 #define ROP_BLUE 0b10101010
@@ -392,15 +392,50 @@ void initGraphics()
 
 bool saveScreenBuffer()
 {
+#ifdef PAGE_FLIP
+    // Draw on the other page, leaving the one shown as is (see drawPage)
+    drawPage(state.page ^ 1);
+    return true;
+#else
     // No room on CoCo 32K for second page
     return false;
+#endif
 }
 
 void restoreScreenBuffer()
 {
+#ifdef PAGE_FLIP
+    drawPage(state.page);
+    showPage(state.page);
+#else
     // No-op on CoCo
+#endif
+}
+
+#ifdef PAGE_FLIP
+void drawPage(uint8_t page)
+{
+    static uint8_t i;
+
+    if (page == drawnPage)
+        return;
+
+    // Map the page into task 1 at $8000, where the hires routines draw
+    drawnPage = page;
+    for (i = 0; i < 4; i++)
+        *(byte *)(0xFFAC + i) = task1MMUBlocks[4 + i] - page * 4;
+
+    // The tile cache describes the other page
+    hires_ForgetAll();
 }
 
+void showPage(uint8_t page)
+{
+    waitvsync();
+    *(uint16_t *)0xFF9D = page ? 0xC000 : 0xD000;
+}
+#endif
+
 void drawEndgameMessage(const char *message)
 {
     uint8_t i, x;
@@ -680,6 +715,7 @@ void resetScreen()
     pcls(0);
 #endif
     END_GFX
+    hires_ForgetAll();
 }
 
 void drawLegendShip(uint8_t player, uint8_t index, uint8_t size, uint8_t status)
@@ -768,6 +804,21 @@ void drawGamefieldUpdate(uint8_t quadrant, uint8_t *gamefield, uint8_t attackPos
     hires_Draw(quadrant_offset_xy[quadrant][0] + fieldX + (attackPos % 10), quadrant_offset_xy[quadrant][1] + (attackPos / 10) * 8, 1, 8, ROP_CPY, src);
 }
 
+void drawGamefieldCells(uint8_t quadrant, uint8_t *gamefield, uint8_t *cells, uint8_t count)
+{
+    uint8_t pos, y, x = quadrant_offset_xy[quadrant][0] + fieldX;
+
+    while (count--)
+    {
+        pos = *cells++;
+        if (gamefield[pos])
+        {
+            y = pos / 10;
+            hires_Draw(x + pos - y * 10, quadrant_offset_xy[quadrant][1] + y * 8, 1, 8, ROP_CPY, gamefield[pos] == FIELD_ATTACK ? srcHit : srcMiss);
+        }
+    }
+}
+
 void drawGamefield(uint8_t quadrant, uint8_t *field)
 {
     uint8_t y, x, j;
@@ -880,7 +931,13 @@ void drawSpace(uint8_t x, uint8_t y, uint8_t w)
     y = y * 8 + OFFSET_Y;
     if (y > 184)
         y = 184;
+#ifdef TILE_SHADOW
+    // Blank with spaces, so cells that are already blank are skipped
+    while (w--)
+        hires_putc(x++, y, ROP_CPY, ' ');
+#else
     hires_Mask(x, y, w, 8, 0);
+#endif
 }
 
 void drawBoard(uint8_t currentPlayerCount)
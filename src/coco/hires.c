@@ -4,10 +4,62 @@
 ROP_TYPE background = 0;
 extern uint8_t charset[];
 
+void hires_DrawTiles(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, ROP_TYPE rop, uint8_t *src);
+void hires_MaskArea(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, uint8_t c);
+
+#ifdef TILE_SHADOW
+// Character last copied to each text grid cell, plus one (0 = unknown).
+// A 4bpp character is 32 bytes of video writes, so redrawing the same text is skipped
+static uint8_t tileShadow[HEIGHT][WIDTH];
+
+/*-----------------------------------------------------------------------*/
+// Marks the text grid cells touched by a pixel area as unknown
+void hires_Forget(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen)
+{
+    uint8_t row, last;
+
+    if (x >= WIDTH || y + ylen <= OFFSET_Y)
+        return;
+
+    row = y < OFFSET_Y ? 0 : (y - OFFSET_Y) >> 3;
+    last = (y + ylen - 1 - OFFSET_Y) >> 3;
+    if (last >= HEIGHT)
+        last = HEIGHT - 1;
+    if (x + xlen > WIDTH)
+        xlen = WIDTH - x;
+
+    for (; row <= last; row++)
+        memset(&tileShadow[row][x], 0, xlen);
+}
+
+void hires_ForgetAll()
+{
+    memset(tileShadow, 0, sizeof(tileShadow));
+}
+#else
+#define hires_Forget(x, y, xlen, ylen)
+#endif
+
 /*-----------------------------------------------------------------------*/
 void hires_putc(uint8_t x, uint8_t y, ROP_TYPE rop, uint8_t c)
 {
-    hires_Draw(x, y, 1, 8, rop, &charset[(uint16_t)c CHAR_SHIFT]);
+#ifdef TILE_SHADOW
+    static uint8_t *cell;
+
+    // Only plain copies on the text grid are remembered
+    if ((y & 7) == OFFSET_Y && rop == ROP_CPY && !background && x < WIDTH && y >> 3 < HEIGHT)
+    {
+        cell = &tileShadow[y >> 3][x];
+        if (*cell == (uint8_t)(c + 1))
+            return;
+        *cell = c + 1;
+    }
+    else
+    {
+        hires_Forget(x, y, 1, 8);
+    }
+#endif
+    hires_DrawTiles(x, y, 1, 8, rop, &charset[(uint16_t)c CHAR_SHIFT]);
 }
 
 /*-----------------------------------------------------------------------*/
@@ -18,6 +70,12 @@ void hires_putcc(uint8_t x, uint8_t y, ROP_TYPE rop, uint16_t cc)
 }
 
 void hires_Mask(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, uint8_t c)
+{
+    hires_Forget(x, y, xlen, ylen);
+    hires_MaskArea(x, y, xlen, ylen, c);
+}
+
+void hires_MaskArea(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, uint8_t c)
 {
 #ifdef COCO3
     uint8_t *pos = (uint8_t *)SCREEN + (uint16_t)y * (WIDTH * 4) + x * 4;
@@ -41,6 +99,12 @@ void hires_Mask(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, uint8_t c)
 }
 
 void hires_Draw(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, ROP_TYPE rop, uint8_t *src)
+{
+    hires_Forget(x, y, xlen, ylen);
+    hires_DrawTiles(x, y, xlen, ylen, rop, src);
+}
+
+void hires_DrawTiles(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, ROP_TYPE rop, uint8_t *src)
 {
 #ifdef COCO3
     uint16_t *dest = (uint16_t *)SCREEN + (uint16_t)y * (WIDTH * 2) + x * 2;
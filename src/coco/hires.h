@@ -8,6 +8,12 @@ void hires_putcc(uint8_t x, uint8_t y, ROP_TYPE rop, unsigned cc);
 void hires_Mask(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, uint8_t c);
 void hires_Draw(uint8_t x, uint8_t y, uint8_t xlen, uint8_t ylen, ROP_TYPE rop, uint8_t *src);
 
+#ifdef TILE_SHADOW
+void hires_ForgetAll();
+#else
+#define hires_ForgetAll()
+#endif
+
 #ifdef COCO3
 // Defines to switch to the particular MMU task
 #define task0()              \
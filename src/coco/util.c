@@ -120,3 +120,17 @@ uint8_t getRandomNumber(uint8_t maxExclusive)
     srand((*(uint16_t *)0x112));
     return (uint8_t)(rand() % maxExclusive);
 }
+
+void initTransferSpeed()
+{
+    // Not supported on CoCo
+}
+
+void fallbackTransferSpeed()
+{
+}
+
+uint8_t getTransferKbps()
+{
+    return 0;
+}
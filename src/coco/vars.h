@@ -10,16 +10,22 @@
 #define CHAR_SHIFT << 5 // 4bpp characters
 #define SCREEN 0x8000U
 #define ROP_TYPE uint16_t
+#define ROP_CPY 0xffff
 #define BPC 4 // Bytes per character
+#define TILE_SHADOW     // Skip redrawing characters already on screen (see hires.c)
+#define PAGE_FLIP       // Two screen pages (see drawPage)
 #else
 #define WIDTH 32
 #define HEIGHT 24
 #define CHAR_SHIFT << 3 // 2bpp characters
 #define SCREEN 0x6000U
 #define ROP_TYPE uint8_t
+#define ROP_CPY 0xff
 #define BPC 1 // Bytes per character
 #endif
 
+#define OFFSET_Y 2 // Pixel row of the text grid within each 8 row band
+
 // Other platform specific constnats
 
 #define GAMEOVER_PROMPT_Y HEIGHT - 2
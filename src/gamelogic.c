@@ -32,8 +32,6 @@ void progressAnim(uint8_t y)
 
 void processStateChange()
 {
-    static uint8_t i;
-
     switch (clientState.game.status)
     {
     case STATUS_LOBBY:
@@ -50,13 +48,7 @@ void processStateChange()
     state.prevActivePlayer = clientState.game.activePlayer;
     state.prevAttackPos = clientState.game.lastAttackPos;
 
-    if (clientState.game.status >= STATUS_GAMESTART)
-    {
-        for(i=0;i<clientState.game.playerCount;i++)
-        {
-            memcpy(&state.gamefield[i], &clientState.game.players[i].gamefield, 100);
-        }
-    } 
+    // state.gamefield is kept in sync by renderGameboard, cell by cell as it draws them
 }
 
 #define READY_LEFT WIDTH / 2 - 8
@@ -276,9 +268,119 @@ void handleShipPlacement()
             strcat(moveBuffer, ",");
     }
 
-    sendMove(moveBuffer);
+    // The placement can not be made again, so make room in the queue for it. Polling for room
+    // here would drop the state changes read meanwhile, so the queue is sent without polls
+    if (!sendMove(moveBuffer))
+    {
+        flushRequests();
+        sendMove(moveBuffer);
+    }
+}
+
+/*
+ * @brief Draws the cells of a player's gamefield that differ from shadow (NULL for the empty board
+ * drawn by drawBoard), other than skipPos, in one batched call. Drawn cells are copied to shadow
+ */
+void drawChangedCells(uint8_t player, uint8_t *shadow, uint8_t skipPos)
+{
+    static uint8_t pos, count, *field, *cells;
+
+    field = clientState.game.players[player].gamefield;
+    cells = (uint8_t *)tempBuffer;
+    count = 0;
+
+    for (pos = 0; pos < 100; pos++)
+    {
+        if (field[pos] != (shadow ? shadow[pos] : 0) && pos != skipPos)
+            cells[count++] = pos;
+    }
+
+    if (!count)
+        return;
+
+    drawGamefieldCells(player, field, cells, count);
+
+    if (shadow)
+    {
+        while (count--)
+            shadow[cells[count]] = field[cells[count]];
+    }
+}
+
+/// @brief Draws attacks made since the last state, other than the last attack, which renderGameboard animates.
+/// Found by comparing the gamefields to the previous state, and played back quickly if animate is set.
+void playMissedAttacks(bool animate)
+{
+    static uint8_t i, j, pos;
+    static bool changed;
+
+    // Without playback, only the changed cells of each board are drawn
+    if (!animate)
+    {
+        for (i = 0; i < clientState.game.playerCount; i++)
+            drawChangedCells(i, state.gamefield[i], clientState.game.lastAttackPos);
+        return;
+    }
+
+    for (pos = 0; pos < 100; pos++)
+    {
+        if (pos == clientState.game.lastAttackPos)
+            continue;
+
+        changed = false;
+        for (i = 0; i < clientState.game.playerCount; i++)
+        {
+            if (state.gamefield[i][pos] != clientState.game.players[i].gamefield[pos])
+                changed = true;
+        }
+
+        if (!changed)
+            continue;
+
+        for (j = 10; j < 17; j++)
+        {
+            for (i = 0; i < clientState.game.playerCount; i++)
+            {
+                if (state.gamefield[i][pos] != clientState.game.players[i].gamefield[pos])
+                    drawGamefieldUpdate(i, clientState.game.players[i].gamefield, pos, j < 16 ? j : 0);
+            }
+            if (j < 16)
+                pause(2);
+        }
+
+        for (i = 0; i < clientState.game.playerCount; i++)
+        {
+            state.gamefield[i][pos] = clientState.game.players[i].gamefield[pos];
+        }
+    }
+}
+
+#ifdef PAGE_FLIP
+// Set while a redraw is drawn on the page not shown
+static bool boardOffscreen = false;
+
+/// @brief Directs a redraw to the page not shown, so it appears at once
+void hideBoardRedraw()
+{
+    drawPage(state.page ^ 1);
+    boardOffscreen = true;
 }
 
+/// @brief Flips to the redrawn board, if not shown yet
+void showBoardRedraw()
+{
+    if (boardOffscreen)
+    {
+        boardOffscreen = false;
+        state.page ^= 1;
+        showPage(state.page);
+    }
+}
+#else
+#define hideBoardRedraw()
+#define showBoardRedraw()
+#endif
+
 void renderGameboard()
 {
 #define LEGEND_X WIDTH / 2 + 8
@@ -294,6 +396,7 @@ void renderGameboard()
         state.drawBoard = false;
         redraw = true;
         skipAnim = true;
+        hideBoardRedraw();
         resetScreen();
         drawBoard(clientState.game.status == STATUS_PLACE_SHIPS ? 1 : clientState.game.playerCount);
 
@@ -313,10 +416,11 @@ void renderGameboard()
                 }
             }
 
-            // Draw gamefield
+            // Draw gamefield. drawBoard drew the empty boards, so only attacked cells are drawn
             for (i = 0; i < clientState.game.playerCount; i++)
             {
-                drawGamefield(i, clientState.game.players[i].gamefield);
+                drawChangedCells(i, NULL, 0xFF);
+                memcpy(state.gamefield[i], clientState.game.players[i].gamefield, 100);
             }
         }
     }
@@ -333,6 +437,11 @@ void renderGameboard()
         // Render gamefield updates
         if (clientState.game.status > STATUS_GAMESTART)
         {
+            // Catch up on attacks made since the last poll. A redraw has already drawn them
+            if (!redraw)
+            {
+                playMissedAttacks(!skipAnim);
+            }
 
             // Animate other player's attack
             if (!skipAnim && state.prevActivePlayer != 0)
@@ -371,6 +480,12 @@ void renderGameboard()
 
                 pause(4);
             }
+
+            // The last attack is drawn, so track it. Other changes were tracked by playMissedAttacks
+            for (i = 0; i < clientState.game.playerCount && clientState.game.lastAttackPos < 100; i++)
+            {
+                state.gamefield[i][clientState.game.lastAttackPos] = clientState.game.players[i].gamefield[clientState.game.lastAttackPos];
+            }
         }
 
         for (i = 0; i < clientState.game.playerCount; i++)
@@ -399,6 +514,9 @@ void renderGameboard()
             memcpy(state.shipsLeft[i], clientState.game.players[i].shipsLeft, 5);
         }
 
+        // Names blink, so show the board first
+        showBoardRedraw();
+
         if (clientState.game.status != STATUS_GAMEOVER || redraw || clientState.game.status != state.prevStatus)
         {
             // Clear active player
@@ -433,6 +551,8 @@ void renderGameboard()
         }
     }
 
+    showBoardRedraw();
+
     // Display the gameover message and play a sound if the state just changed
     if (clientState.game.status == STATUS_GAMEOVER && (redraw || clientState.game.status != state.prevStatus))
     {
@@ -522,6 +642,7 @@ bool testShip(uint8_t shipSize, uint8_t pos)
 void processInput()
 {
     waitvsync();
+    state.stateFrames++;
     readCommonInput();
 
     if (state.waitingOnEndGameContinue)
@@ -537,6 +658,14 @@ void processInput()
         // Toggle readiness if waiting to start game
         if (clientState.game.status == STATUS_LOBBY && input.trigger)
         {
+            // Refuse the toggle until the queued requests are sent
+            if (!sendMove("ready"))
+            {
+                soundInvalid();
+                clearCommonInput();
+                return;
+            }
+
             clientState.lobby.playerStatus = clientState.lobby.playerStatus ? PLAYER_STATUS_DEFAULT : PLAYER_STATUS_READY;
             clientState.lobby.players[0].ready = clientState.lobby.playerStatus;
             renderLobby();
@@ -546,7 +675,6 @@ void processInput()
             else
                 soundInvalid();
 
-            apiCall("ready");
             clearCommonInput();
             return;
         }
@@ -573,11 +701,18 @@ void waitOnPlayerMove()
     uint8_t waitCount, frames, lastFrame, i, j, moved, attackPos;
     uint16_t jifsPerSecond, maxJifs;
 
-    resetTimer();
-
     // Determine max jiffies for PAL and NTS
     jifsPerSecond = getJiffiesPerSecond();
     maxJifs = jifsPerSecond * clientState.game.moveTime;
+
+    // Count time passed since the state was received (e.g. rendering) against the move time
+    // Leave at least a second to move
+    if (maxJifs > jifsPerSecond)
+    {
+        maxJifs = state.stateFrames < maxJifs - jifsPerSecond ? maxJifs - state.stateFrames : jifsPerSecond;
+    }
+
+    resetTimer();
     waitCount = 0;
     moved = frames = 9;
 
@@ -630,9 +765,13 @@ void waitOnPlayerMove()
                     break;
             }
 
-            if (i == clientState.game.playerCount)
+            // Send command to score this value
+            strcpy(moveBuffer, "attack/");
+            itoa(attackPos, moveBuffer + strlen(moveBuffer), 10);
+
+            if (i == clientState.game.playerCount || !sendMove(moveBuffer))
             {
-                // Invalid location
+                // Invalid location, or earlier requests are still queued
                 soundInvalid();
             }
             else 
@@ -651,11 +790,6 @@ void waitOnPlayerMove()
                     pause(5);
                 }
 
-                // Send command to score this value
-                strcpy(moveBuffer, "attack/");
-                itoa(attackPos, moveBuffer + strlen(moveBuffer), 10);
-                sendMove(moveBuffer);
-
                 // Clear timer
                 drawSpace(WIDTH - TIMER_WIDTH - 2, HEIGHT - 1, 2 + TIMER_WIDTH);
                 return;
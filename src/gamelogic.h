@@ -4,6 +4,8 @@
 void processStateChange();
 void renderLobby();
 void renderGameboard();
+void drawChangedCells(uint8_t player, uint8_t *shadow, uint8_t skipPos);
+void playMissedAttacks(bool animate);
 void handleAnimation();
 
 void processInput();
@@ -16,6 +16,7 @@
 #include "stateclient.h"
 #include "gamelogic.h"
 #include "screens.h"
+#include "telemetry.h"
 
 
 // Store default public server endpoint in case lobby did not set app key
@@ -50,6 +51,8 @@ void main(void)
     loadPrefs();    
     initGraphics();
     initSound();
+    initTransferSpeed();
+    telemetryInit();
 
     // soundCursor();
     // cgetc();
@@ -90,8 +93,8 @@ void main(void)
     while (true)
     {
 
-        // Poll the server every so often.
-        if (!state.apiCallWait--)
+        // Poll the server every so often. The reply is read a chunk per frame
+        if (apiCallBusy() || !state.apiCallWait--)
         {
 
             // Housekeeping - allows platform specific housekeeping, like stopping Attract/screensaver mode in Atari
@@ -100,14 +103,23 @@ void main(void)
             // Poll the server
             switch (getStateFromServer())
             {
+            case STATE_UPDATE_PENDING:
+                break;
+
             case STATE_UPDATE_ERROR:
-                // ERROR - Wait a bit to avoid hammering the server if getting bad responses
-                // Wait max 4 seconds (since 4*60=240 fits in a single byte)
-                if (failedApiCalls < 4)
+                // ERROR - Back off to avoid hammering the server if getting bad responses
+                if (failedApiCalls < 5)
                 {
                     failedApiCalls++;
                 }
-                state.apiCallWait = 60 * failedApiCalls;
+
+                // After several failures in a row, move on to the next server endpoint, if any
+                if (failedApiCalls == ENDPOINT_FAILOVER_CALLS && nextEndpoint())
+                {
+                    failedApiCalls = 1;
+                }
+
+                schedulePoll(STATE_UPDATE_ERROR, failedApiCalls);
 
                 // After consequitive failures, let the player know we are experiencing technical difficulties
                 if (failedApiCalls > 1)
@@ -128,10 +140,30 @@ void main(void)
                     drawConnectionIcon(false);
                 }
                 failedApiCalls = 0;
+
+                telemetryMark();
                 processStateChange();
+                telemetryRender();
 
                 // Poll again in a bit
-                state.apiCallWait = 59;
+                schedulePoll(STATE_UPDATE_CHANGE, 0);
+                break;
+
+            case STATE_UPDATE_NOCHANGE:
+
+                // Nothing to render, but keep the lobby ready indicators animating
+                if (failedApiCalls > 1)
+                {
+                    drawConnectionIcon(false);
+                }
+                failedApiCalls = 0;
+
+                if (clientState.game.status == STATUS_LOBBY)
+                {
+                    renderLobby();
+                }
+
+                schedulePoll(STATE_UPDATE_NOCHANGE, 0);
                 break;
             }
         }
@@ -28,7 +28,10 @@ void custom_write_appkey(uint16_t creator_id, uint8_t app_id, uint8_t key_id, ui
 void pause(uint8_t frames)
 {
     while (frames--)
+    {
         waitvsync();
+        state.stateFrames++;
+    }
 }
 
 void clearCommonInput()
@@ -151,8 +154,107 @@ void readCommonInput()
     }
 }
 
+// Appkeys this game writes are read once at startup and kept in RAM. Writes only
+// update RAM, and changed keys are sent to FujiNet together by flushAppKeys
+#define APPKEY_CACHE_COUNT 3
+#define APPKEY_MAX_LEN 64
+
+typedef struct
+{
+    uint16_t creatorId;
+    uint8_t appId;
+    uint8_t keyId;
+    bool loaded;
+    bool dirty;
+    uint8_t len;
+    char value[APPKEY_MAX_LEN];
+} AppKeyCache;
+
+static AppKeyCache appKeys[APPKEY_CACHE_COUNT] = {
+    {AK_CREATOR_ID, AK_APP_ID, AK_KEY_PREFS},
+    {AK_LOBBY_CREATOR_ID, AK_LOBBY_APP_ID, AK_LOBBY_KEY_USERNAME},
+    {AK_LOBBY_CREATOR_ID, AK_LOBBY_APP_ID, AK_LOBBY_KEY_SERVER}};
+
+uint16_t readAppKeyFromFuji(uint16_t creator_id, uint8_t app_id, uint8_t key_id, char *destination)
+{
+    uint16_t read = 0;
+
+    #ifdef CUSTOM_FUJINET_CALLS
+        read = custom_read_appkey(creator_id, app_id, key_id, destination);
+    #else
+        fuji_set_appkey_details(creator_id, app_id, DEFAULT);
+        if (!fuji_read_appkey(key_id, &read, (uint8_t *)destination))
+            read = 0;
+    #endif
+
+    return read;
+}
+
+void writeAppKeyToFuji(uint16_t creator_id, uint8_t app_id, uint8_t key_id, uint16_t count, char *data)
+{
+    #ifdef CUSTOM_FUJINET_CALLS
+        custom_write_appkey(creator_id, app_id, key_id, count, data);
+    #else
+        fuji_set_appkey_details(creator_id, app_id, DEFAULT);
+        fuji_write_appkey(key_id, count, (uint8_t *)data);
+    #endif
+}
+
+/// @brief Returns the cache entry for an appkey, or NULL if it is not cached
+AppKeyCache *findAppKey(uint16_t creator_id, uint8_t app_id, uint8_t key_id)
+{
+    static uint8_t i;
+    for (i = 0; i < APPKEY_CACHE_COUNT; i++)
+    {
+        if (appKeys[i].keyId == key_id && appKeys[i].appId == app_id && appKeys[i].creatorId == creator_id)
+            return &appKeys[i];
+    }
+    return NULL;
+}
+
+/// @brief Reads every cached appkey from FujiNet in one pass
+void loadAppKeys()
+{
+    static uint8_t i;
+    static uint16_t read;
+    static AppKeyCache *key;
+
+    for (i = 0; i < APPKEY_CACHE_COUNT; i++)
+    {
+        key = &appKeys[i];
+        read = readAppKeyFromFuji(key->creatorId, key->appId, key->keyId, tempBuffer);
+        key->dirty = false;
+
+        // Keys too long to cache are read from FujiNet each time instead
+        key->loaded = read <= APPKEY_MAX_LEN;
+        if (key->loaded)
+        {
+            key->len = (uint8_t)read;
+            memcpy(key->value, tempBuffer, key->len);
+        }
+    }
+}
+
+void flushAppKeys()
+{
+    static uint8_t i;
+    static AppKeyCache *key;
+
+    for (i = 0; i < APPKEY_CACHE_COUNT; i++)
+    {
+        key = &appKeys[i];
+        if (key->dirty)
+        {
+            writeAppKeyToFuji(key->creatorId, key->appId, key->keyId, key->len, key->value);
+            key->dirty = false;
+        }
+    }
+}
+
 void loadPrefs()
 {
+    loadAppKeys();
+
     memset(&prefs, 0, sizeof(prefs));
     if (read_appkey(AK_CREATOR_ID, AK_APP_ID, AK_KEY_PREFS, tempBuffer))
     {
@@ -173,15 +275,19 @@ void savePrefs()
 
 uint16_t read_appkey(uint16_t creator_id, uint8_t app_id, uint8_t key_id, char *destination)
 {
-    uint16_t read = 0;
+    static AppKeyCache *key;
+    uint16_t read;
 
-    #ifdef CUSTOM_FUJINET_CALLS
-        read = custom_read_appkey(creator_id, app_id, key_id, destination);
-    #else
-        fuji_set_appkey_details(creator_id, app_id, DEFAULT);
-        if (!fuji_read_appkey(key_id, &read, (uint8_t *)destination))
-            read = 0;
-    #endif
+    key = findAppKey(creator_id, app_id, key_id);
+    if (key && key->loaded)
+    {
+        read = key->len;
+        memcpy(destination, key->value, read);
+    }
+    else
+    {
+        read = readAppKeyFromFuji(creator_id, app_id, key_id, destination);
+    }
 
     // Add string terminator after the data ends in case it is being interpreted as a string
     destination[read] = 0;
@@ -190,10 +296,26 @@ uint16_t read_appkey(uint16_t creator_id, uint8_t app_id, uint8_t key_id, char *
 
 void write_appkey(uint16_t creator_id, uint8_t app_id, uint8_t key_id, uint16_t count, char *data)
 {
-    #ifdef CUSTOM_FUJINET_CALLS
-        custom_write_appkey(creator_id, app_id, key_id, count, data);
-    #else
-        fuji_set_appkey_details(creator_id, app_id, DEFAULT);
-        fuji_write_appkey(key_id, count, (uint8_t *)data);
-    #endif
+    static AppKeyCache *key;
+
+    key = findAppKey(creator_id, app_id, key_id);
+
+    // Keys that are not cached, or too long to cache, are written right away
+    if (!key || count > APPKEY_MAX_LEN)
+    {
+        if (key)
+        {
+            key->loaded = key->dirty = false;
+        }
+        writeAppKeyToFuji(creator_id, app_id, key_id, count, data);
+        return;
+    }
+
+    // Drop writes that do not change the value
+    if (key->loaded && key->len == count && !memcmp(key->value, data, count))
+        return;
+
+    key->len = (uint8_t)count;
+    memcpy(key->value, data, count);
+    key->loaded = key->dirty = true;
 }
@@ -19,8 +19,14 @@
 #include "platform-specific/sound.h"
 #include "platform-specific/vars.h"
 
-// Client version string to send to server
+// Client version string to send to server.
+// Define COMPACT_STATE in vars.h to ask for the packed v3 game state instead (see expandCompactState).
+// The server must support it, e.g. support/server/standin.py
+#ifdef COMPACT_STATE
+#define API_CLIENT_VERSION "3"
+#else
 #define API_CLIENT_VERSION "2"
+#endif
 
 // FujiNet AppKey settings. These should not be changed
 #define AK_LOBBY_CREATOR_ID 1   // FUJINET Lobby
@@ -32,6 +38,8 @@
 #define AK_CREATOR_ID 0xE41C // Eric Carr's creator id
 #define AK_APP_ID 5          // Battleship App ID
 #define AK_KEY_PREFS 0       // Preferences
+#define AK_KEY_ENDPOINTS 1   // Extra server endpoints to choose from, separated by spaces
+#define AK_KEY_TELEMETRY 2   // Telemetry collector url (see telemetry.h)
 
 #define PLAYER_MAX 4
 
@@ -85,6 +93,11 @@ typedef struct
     uint8_t ready;
 } LobbyPlayer;
 
+// Tables shown per page of the table list. Set in [platform]/vars.h to override
+#ifndef TABLES_PAGE
+#define TABLES_PAGE ((HEIGHT - 10) / 2)
+#endif
+
 typedef struct
 {
     uint8_t count;
@@ -134,7 +147,8 @@ typedef struct
     uint8_t prevPlayerCount;
     uint8_t prevStatus;
     uint8_t prevPlayerStatus;
-    uint8_t apiCallWait;
+    uint16_t apiCallWait;
+    uint16_t stateFrames; // Frames waited since the state was received, for the move timer
 
     int8_t prevActivePlayer;
     int8_t prevAttackPos;
@@ -143,6 +157,7 @@ typedef struct
     bool waitingOnEndGameContinue;
     bool drawBoard;
     bool inGame;
+    uint8_t page; // Screen page (0-1) showing the game, when PAGE_FLIP is defined
 
     // Track gamefield state - used to know when to fire shoot animation
     uint8_t gamefield[PLAYER_MAX][100];
@@ -187,11 +202,14 @@ void readCommonInput();
 void loadPrefs();
 void savePrefs();
 
-/// @brief Helper method to write to an appkey
+/// @brief Helper method to write to an appkey. Prefs and lobby keys are held in RAM until flushAppKeys
 void write_appkey(uint16_t creator_id, uint8_t app_id, uint8_t key_id, uint16_t count, char *data);
 
 /// @brief Helper method to read from an appkey.
 /// NULL will be appended to data in case this is a string, though the length returned will not consider the NULL.
 uint16_t read_appkey(uint16_t creator_id, uint8_t app_id, uint8_t key_id, char *destination);
 
+/// @brief Sends appkeys changed since the last flush to FujiNet
+void flushAppKeys();
+
 #endif /* MISC_H */
@@ -7,6 +7,7 @@
 
 #include <stdbool.h>
 #include <conio.h>
+#include <malloc.h>
 #include "vars.h"
 #include "../misc.h"
 #include <stdio.h>
@@ -41,6 +42,21 @@ unsigned char far *video = VIDEO_RAM_ADDR;
  */
 #define VIDEO_ODD_OFFSET 0x2000
 
+/**
+ * @brief bytes used in each bank (100 lines)
+ */
+#define VIDEO_BANK_BYTES 8000
+
+/**
+ * @brief far copy of both video banks, for saveScreenBuffer
+ */
+static unsigned char far *screenBak = NULL;
+
+/**
+ * @brief tile_offset of the saved screen
+ */
+static unsigned char savedTileOffset = 0;
+
 /**
  * @brief previous video mode
  */
@@ -91,6 +107,30 @@ static unsigned char inGameCharSet = 0;
  */
 static bool cursorVisible = false;
 
+/**
+ * @brief Tile key last drawn at each cell (0 = unknown)
+ * @verbose Text and icons redrawn unchanged skip the 16 byte video write.
+ * Icons are keyed icon+1, characters by color/inverse and char (see plot_char).
+ */
+static uint16_t tileShadow[HEIGHT][WIDTH];
+
+/**
+ * @brief Record the tile about to be drawn at x,y
+ * @param key Tile key (non zero)
+ * @return false if the cell already shows that tile
+ */
+static bool tileChanged(unsigned char x, unsigned char y, uint16_t key)
+{
+    if (x >= WIDTH || y >= HEIGHT)
+        return true;
+
+    if (tileShadow[y][x] == key)
+        return false;
+
+    tileShadow[y][x] = key;
+    return true;
+}
+
 /**
  * @brief plot a 8x8 2bpp tile to screen at column x, row y
  * @param tile ptr to 2bpp tile data * 8
@@ -145,6 +185,9 @@ void plot_char(unsigned char x,
     unsigned char mask = 0xFF;
     unsigned char i=0;
 
+    if (!tileChanged(x, y, (uint16_t)((color | xor << 2) + 2) << 8 | (unsigned char)c))
+        return;
+
     // Optimization to just call plot_tile directly
     // If we're just doing white on color 0.
     if (i==0 && color == 3)
@@ -202,10 +245,11 @@ void plotName(unsigned char x, unsigned char y, unsigned char color, const char
 void resetScreen(void)
 {
     waitvsync();
-    _fmemset(&video[0x0000], 0, 8000);
-    _fmemset(&video[0x2000], 0, 8000);
+    _fmemset(&video[0x0000], 0, VIDEO_BANK_BYTES);
+    _fmemset(&video[VIDEO_ODD_OFFSET], 0, VIDEO_BANK_BYTES);
     waitvsync();
     tile_offset=0;
+    memset(tileShadow, 0, sizeof(tileShadow));
 }
 
 /**
@@ -307,22 +351,33 @@ void resetGraphics(void)
 
 /**
  * @brief Store screen buffer into secondary buffer
- * @verbose not used.
+ * @verbose Copies both CGA banks (8000 bytes each) to a far buffer,
+ * allocated on first use. Returns false if there is no memory for it.
  */
 bool saveScreenBuffer()
 {
-    return false;
-    // memcpy(SCREEN_BAK, SCREEN_LOC, WIDTH * HEIGHT);
+    if (!screenBak)
+        screenBak = _fmalloc(VIDEO_BANK_BYTES * 2);
+
+    if (!screenBak)
+        return false;
+
+    _fmemcpy(screenBak, &video[0x0000], VIDEO_BANK_BYTES);
+    _fmemcpy(screenBak + VIDEO_BANK_BYTES, &video[VIDEO_ODD_OFFSET], VIDEO_BANK_BYTES);
+    savedTileOffset = tile_offset;
+    return true;
 }
 
 /**
  * @brief Restore screen buffer from secondary buffer
- * @verbose not used.
  */
 void restoreScreenBuffer()
 {
-    // waitvsync();
-    // memcpy(SCREEN_LOC, SCREEN_BAK, WIDTH * HEIGHT);
+    waitvsync();
+    _fmemcpy(&video[0x0000], screenBak, VIDEO_BANK_BYTES);
+    _fmemcpy(&video[VIDEO_ODD_OFFSET], screenBak + VIDEO_BANK_BYTES, VIDEO_BANK_BYTES);
+    tile_offset = savedTileOffset;
+    memset(tileShadow, 0, sizeof(tileShadow));
 }
 
 /**
@@ -380,7 +435,8 @@ void waitvsync()
  */
 void drawIcon(unsigned char x, unsigned char y, unsigned char icon)
 {
-    plot_tile(&charset[icon], x, y);
+    if (tileChanged(x, y, icon + 1))
+        plot_tile(&charset[icon], x, y);
 }
 
 /**
@@ -390,7 +446,7 @@ void drawIcon(unsigned char x, unsigned char y, unsigned char icon)
  */
 void drawBlank(unsigned char x, unsigned char y)
 {
-    plot_tile(&charset[0x00], x, y);
+    drawIcon(x, y, 0x00);
 }
 
 /**
@@ -574,6 +630,11 @@ void drawPlayerName(unsigned char player, const char *name, bool active)
 void drawBoard(unsigned char currentPlayerCount)
 {
     int i=0;
+
+    // Top tiles move down, so the cells no longer show what was drawn
+    if (tile_offset != 2)
+        memset(tileShadow, 0, sizeof(tileShadow));
+
     tile_offset = 2;
     playerCount = currentPlayerCount;
 
@@ -594,7 +655,7 @@ void drawBoard(unsigned char currentPlayerCount)
 void drawLine(unsigned char x, unsigned char y, unsigned char w)
 {
     while (w--)
-        plot_tile(&charset[0x3F], x++, y);
+        drawIcon(x++, y, 0x3F);
 }
 
 /**
@@ -758,6 +819,32 @@ void xorCursor(void)
 }
 
 
+/**
+ * @brief Draw the listed cells of the game field for given quadrant
+ */
+void drawGamefieldCells(uint8_t quadrant, uint8_t *gamefield, uint8_t *cells, uint8_t count)
+{
+    uint8_t pos, iy;
+    uint8_t x = quadrant_offset[quadrant][0] + fieldX;
+    uint8_t y = quadrant_offset[quadrant][1];
+
+    if (cursorVisible)
+    {
+        cursorVisible=false;
+        xorCursor();
+    }
+
+    while (count--)
+    {
+        pos = *cells++;
+        if (gamefield[pos])
+        {
+            iy = pos / 10;
+            drawIcon(x + pos - iy * 10, y + iy, gamefield[pos] == FIELD_ATTACK ? 0x39 : 0xE1);
+        }
+    }
+}
+
 void drawGamefieldUpdate(uint8_t quadrant, uint8_t *gamefield, uint8_t attackPos, uint8_t anim)
 {
     uint8_t x=quadrant_offset[quadrant][0] + fieldX + (attackPos % 10);
@@ -121,5 +121,75 @@ uint8_t getJiffiesPerSecond()
 
 uint8_t getRandomNumber(uint8_t maxExclusive)
 {
-    return (uint8_t)rand()&0xff;
+    return (uint8_t)(rand() % maxExclusive);
+}
+
+/* Because I don't want to drag all of conio into this project! */
+_WCIRTLINK extern unsigned inp(unsigned __port);
+_WCIRTLINK extern unsigned outp(unsigned __port, unsigned __value);
+
+// UART registers, from the port base address
+#define UART_DLL 0 // Divisor latch low (DLAB set)
+#define UART_DLM 1 // Divisor latch high (DLAB set)
+#define UART_IIR 2 // Interrupt identification (read)
+#define UART_FCR 2 // FIFO control (write)
+#define UART_LCR 3 // Line control
+
+#define UART_DLAB 0x80
+#define UART_FIFO_ON 0xC7    // Enable and clear both FIFOs, 14 byte trigger
+#define UART_FIFO_OFF 0x00
+#define UART_FIFO_WORKS 0xC0 // IIR bits reported by a 16550A with its FIFO on
+
+static uint16_t uartBase;
+
+/// @brief Returns the i/o base of the COM port FujiNet is on, from FUJI_PORT (1-4) as the FujiNet DOS tools use it
+static uint16_t getUartBase()
+{
+    static char *port;
+    static uint8_t com;
+
+    port = getenv("FUJI_PORT");
+    com = port && port[0] >= '1' && port[0] <= '4' ? port[0] - '1' : 0;
+
+    // The BIOS data area lists the base address of each COM port
+    return *((uint16_t __far *)MK_FP(0x40, com * 2));
+}
+
+void initTransferSpeed()
+{
+    // fujinet-lib polls the UART a byte at a time. A 16550A keeps 16 bytes in its
+    // receive FIFO, so a slow machine drawing the screen does not drop bytes
+    uartBase = getUartBase();
+    if (!uartBase)
+        return;
+
+    outp(uartBase + UART_FCR, UART_FIFO_ON);
+
+    // 8250/16450 have no FIFO, and the FIFO of the original 16550 is unreliable
+    if ((inp(uartBase + UART_IIR) & UART_FIFO_WORKS) != UART_FIFO_WORKS)
+    {
+        outp(uartBase + UART_FCR, UART_FIFO_OFF);
+    }
+}
+
+void fallbackTransferSpeed()
+{
+    // The baud rate is set by fujinet-lib and FUJI_BPS
+}
+
+uint8_t getTransferKbps()
+{
+    static uint8_t lcr;
+    static uint16_t divisor;
+
+    if (!uartBase)
+        return 0;
+
+    // Read the baud rate divisor of the 115200 baud UART clock
+    lcr = inp(uartBase + UART_LCR);
+    outp(uartBase + UART_LCR, lcr | UART_DLAB);
+    divisor = inp(uartBase + UART_DLL) | inp(uartBase + UART_DLM) << 8;
+    outp(uartBase + UART_LCR, lcr);
+
+    return divisor ? 115 / divisor : 0;
 }
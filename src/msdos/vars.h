@@ -18,6 +18,7 @@
 // Other platform specific constnats
 
 #define GAMEOVER_PROMPT_Y HEIGHT - 2
+#define NO_FRAME_TIME // getTime counts its own calls, not frames (see telemetry.h)
 
 // Icons
 #define ICON_TEXT_CURSOR 0x3A
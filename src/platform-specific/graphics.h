@@ -5,6 +5,7 @@
 #ifndef GRAPHICS_H
 #define GRAPHICS_H
 #include "../standard_lib.h"
+#include "vars.h"
 
 // Call to clear the screen, passing true to preserve borders
 void resetScreen();
@@ -49,6 +50,13 @@ void drawEndgameMessage(const char *message);
 /// @param field pointer to 100 byte gamefield array from server
 void drawGamefield(uint8_t quadrant, uint8_t *field);
 
+/// @brief Draw a list of changed cells for the specified gamefield. Empty cells are left as drawn by drawBoard
+/// @param quadrant [0-3] player index
+/// @param gamefield pointer to 100 byte gamefield array from server
+/// @param cells positions [0-99] of the cells to draw
+/// @param count number of cells
+void drawGamefieldCells(uint8_t quadrant, uint8_t *gamefield, uint8_t *cells, uint8_t count);
+
 /// @brief Draw/update a single cell (attackPos) for the the specified gamefield
 /// @param quadrant [0-3] player index
 /// @param gamefield pointer to 100 byte gamefield array from server
@@ -86,12 +94,27 @@ void drawBox(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
 /// The player count dictates the general layout
 void drawBoard(uint8_t playerCount);
 
-/// @brief Call to save screen buffer for later restore. Returns false if screen buffer not supported
+/// @brief Call to save screen buffer for later restore. Returns false if screen buffer not supported.
+/// With PAGE_FLIP, drawing moves to the other page instead, and restoring shows state.page again
 bool saveScreenBuffer();
 
 /// @brief Call to restore screen buffer
 void restoreScreenBuffer();
 
+#ifdef PAGE_FLIP
+// Platforms that define PAGE_FLIP (in vars.h) have two screen pages, 0 and 1. One is shown
+// while the other is drawn, so full redraws and menus appear at once (see state.page)
+
+/// @brief Direct all drawing to the given page (0-1), shown or not
+void drawPage(uint8_t page);
+
+/// @brief Show the given page (0-1) from the next vsync
+void showPage(uint8_t page);
+#else
+#define drawPage(page)
+#define showPage(page)
+#endif
+
 /// @brief Initialize graphics mode
 void initGraphics();
 
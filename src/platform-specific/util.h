@@ -13,4 +13,9 @@ void housekeeping();
 uint8_t getJiffiesPerSecond();
 uint8_t getRandomNumber(uint8_t maxExclusive);
 
+// Faster transfers to the FujiNet, where the platform supports it
+void initTransferSpeed();
+void fallbackTransferSpeed();
+uint8_t getTransferKbps(); // Current rate for diagnostics, 0 if not known
+
 #endif /* UTIL_H */
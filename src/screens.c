@@ -22,12 +22,55 @@
 
 bool inBorderedScreen = false, prevBorderedScreen = false, savedScreen = false;
 
+// Set while the first page of tables is requested in the background, during the welcome screens
+bool tablesPrefetched = false;
+
 bool saveScreen()
 {
     prevBorderedScreen = inBorderedScreen;
     return savedScreen = saveScreenBuffer();
 }
 
+/// @brief Shows a screen drawn over a saved one, once it is complete
+void presentScreen()
+{
+    if (savedScreen)
+        showPage(state.page ^ 1);
+}
+
+/// @brief Keeps the screen drawn over a saved one, instead of restoring
+void keepScreen()
+{
+#ifdef PAGE_FLIP
+    if (savedScreen)
+        state.page ^= 1;
+#endif
+    savedScreen = false;
+}
+
+/// @brief Returns the path to request a page of tables, starting at offset
+const char *tablesPath(uint8_t offset)
+{
+    strcpy(tempBuffer, "tables?offset=");
+    itoa(offset, tempBuffer + strlen(tempBuffer), 10);
+    strcat(tempBuffer, "&count=");
+    itoa(TABLES_PAGE, tempBuffer + strlen(tempBuffer), 10);
+    return tempBuffer;
+}
+
+/// @brief Waits for a key press, reading the prefetched tables meanwhile
+void waitForKey()
+{
+    clearCommonInput();
+    while (!kbhit())
+    {
+        waitvsync();
+        if (tablesPrefetched)
+            apiCallPump();
+    }
+    cgetc();
+}
+
 bool restoreScreen()
 {
     if (savedScreen)
@@ -81,10 +124,19 @@ void showHelpScreen()
     y++;
     drawTextAlt(X, y, "be the last player standing!");
 
+    // Link speed to the FujiNet, for diagnostics
+    if (getTransferKbps())
+    {
+        strcpy(tempBuffer, "link ");
+        itoa(getTransferKbps(), tempBuffer + 5, 10);
+        strcat(tempBuffer, " kbps");
+        centerTextAlt(HEIGHT - 3, tempBuffer);
+    }
+
     centerStatusText("press any key to close");
+    presentScreen();
 
-    clearCommonInput();
-    cgetc();
+    waitForKey();
 }
 
 /// @brief Action called in Welcome Screen to check if a server name is stored in an app key
@@ -109,6 +161,8 @@ void welcomeActionVerifyServerDetails()
             }
         }
     }
+
+    prepareRequests();
 }
 
 void drawLogo()
@@ -168,12 +222,29 @@ void welcomeActionVerifyPlayerName()
 /// @brief Shows the Welcome Screen with Logo. Asks player's name
 void showWelcomeScreen()
 {
-    // Retrieve the main player's name
-    welcomeActionVerifyPlayerName();
-
     // Parse server url from app key if present
     welcomeActionVerifyServerDetails();
 
+    // Unless a table (and so its server) was chosen in the lobby, pick the fastest server.
+    // Then request the table list now, so it is ready when the welcome screens are done
+    if (!query[0])
+    {
+        if (prefs.debugFlag != 0xff)
+        {
+            // Each server is probed in turn, so draw the screen first
+            resetScreen();
+            drawLogo();
+            centerText(12, "finding the fastest server..");
+            selectEndpoint();
+        }
+
+        tablesPrefetched = true;
+        apiCallStart(tablesPath(0));
+    }
+
+    // Retrieve the main player's name
+    welcomeActionVerifyPlayerName();
+
     // If first run, show the help screen
     if (!prefs.seenHelp)
     {
@@ -191,65 +262,143 @@ void showWelcomeScreen()
 /// @brief Shows a screen to select a table to join
 void showTableSelectionScreen()
 {
-    uint8_t shownCursor, tableIndex, blinkCursor, redrawScreen, i, j;
+    static Table shownTable[TABLES_PAGE];
+    uint8_t shownCursor, tableIndex, blinkCursor, redrawScreen, shownRows, tableOffset, pageStart, pageRows, result, i, j;
+    bool moreTables;
     Table *table;
-    state.inGame = tableIndex = blinkCursor = 0;
+    state.inGame = tableIndex = blinkCursor = shownRows = tableOffset = pageStart = pageRows = moreTables = 0;
+    redrawScreen = true;
 
     resetScreen();
 
+    // The request url is rebuilt below, so let the table list asked for by showWelcomeScreen
+    // arrive first. Its result is kept for the first refresh
+    if (tablesPrefetched)
+    {
+        apiCallFinish();
+    }
+    prepareRequests();
+
     // An empty query means a table needs to be selected
     while (strlen(query) == 0)
     {
-        // Show names of local player(s)
+        if (redrawScreen)
+        {
+            // Show names of local player(s)
 
-        strcpy(tempBuffer, "HELLO ");
-        strcat(tempBuffer, playerName);
-        centerTextAlt(20, tempBuffer);
+            strcpy(tempBuffer, "HELLO ");
+            strcat(tempBuffer, playerName);
+            centerTextAlt(20, tempBuffer);
 
-        if (clientState.tables.count > 0)
-        {
-            for (i = 0; i < clientState.tables.count; ++i)
+            for (i = 0; i < shownRows; ++i)
             {
                 drawSpace(LMAR, 9 + i * 2, TWID);
             }
+
+            drawLogo();
+
+            centerText(4, "choose a game to join");
+            drawText(LMAR, 7, "game");
+            drawText(RMAR - 7, 7, "players");
+            drawLine(LMAR, 8, TWID);
         }
+
         waitvsync();
         centerText(12, "      refreshing game list..      ");
 
-        drawLogo();
-
-        centerText(4, "choose a game to join");
-        drawText(LMAR, 7, "game");
-        drawText(RMAR - 7, 7, "players");
-        drawLine(LMAR, 8, TWID);
+        // Ask for a page of tables. The server replies with a single byte if it did not change.
+        // The first page may already have been requested by showWelcomeScreen
+        result = API_CALL_ERROR;
+        if (tablesPrefetched)
+        {
+            tablesPrefetched = false;
+            result = apiCallFinish();
+        }
 
-        // waitvsync();
+        if (result == API_CALL_ERROR)
+        {
+            result = apiCall(tablesPath(tableOffset));
+        }
 
-        clientState.tables.count = 0;
-        apiCall("tables");
+        if (clientState.tables.count & TABLES_MORE)
+        {
+            moreTables = true;
+            clientState.tables.count &= ~TABLES_MORE;
+        }
+        else if (result != API_CALL_NOCHANGE)
+        {
+            moreTables = false;
+        }
 
-        if (clientState.tables.count > 0)
+        // Servers without paging send every table, so page through the full list here
+        pageStart = 0;
+        if (clientState.tables.count > TABLES_PAGE)
         {
-            drawSpace(LMAR, 12, TWID);
-            for (i = 0; i < clientState.tables.count; ++i)
+            if (tableOffset >= clientState.tables.count)
             {
-                table = &clientState.tables.table[i];
-                j = 9 + i * 2;
-                drawTextAlt(LMAR, j, table->name);
-                drawTextAlt(RMAR - 5, j, table->players);
+                tableOffset = 0;
+            }
+            pageStart = tableOffset;
+            moreTables = pageStart + TABLES_PAGE < clientState.tables.count;
+        }
 
-                if (table->players[0] > '0')
-                {
-                    drawIcon(RMAR - 7, j, ICON_PLAYER);
-                }
-                // cgetc();
+        pageRows = clientState.tables.count - pageStart;
+        if (pageRows > TABLES_PAGE)
+        {
+            pageRows = TABLES_PAGE;
+        }
+
+        drawSpace(LMAR, 12, TWID);
+        for (i = 0; i < pageRows; ++i)
+        {
+            table = &clientState.tables.table[pageStart + i];
+
+            // Only redraw rows that changed since the last refresh
+            if (!redrawScreen && i < shownRows && !memcmp(table, &shownTable[i], sizeof(Table)))
+                continue;
+
+            memcpy(&shownTable[i], table, sizeof(Table));
+            j = 9 + i * 2;
+            drawSpace(LMAR, j, TWID);
+            drawTextAlt(LMAR, j, table->name);
+            drawTextAlt(RMAR - 5, j, table->players);
+
+            if (table->players[0] > '0')
+            {
+                drawIcon(RMAR - 7, j, ICON_PLAYER);
             }
+            // cgetc();
         }
-        else
+
+        // Clear rows of tables no longer listed
+        for (; i < shownRows; ++i)
+        {
+            drawBlank(LMAR - 2, 9 + i * 2);
+            drawSpace(LMAR, 9 + i * 2, TWID);
+        }
+
+        shownRows = pageRows;
+        if (tableIndex >= shownRows)
+        {
+            tableIndex = 0;
+        }
+
+        if (!shownRows)
         {
             centerText(12, "no servers are available");
         }
 
+        // Show the page number if there is more than one page
+        drawSpace(WIDTH / 2 - 3, 7, 7);
+        if (tableOffset || moreTables)
+        {
+            strcpy(tempBuffer, "page ");
+            itoa(tableOffset / TABLES_PAGE + 1, tempBuffer + 5, 10);
+            drawText(WIDTH / 2 - 3, 7, tempBuffer);
+        }
+
+        redrawScreen = false;
+
         centerStatusText("Refresh    Help     Name    Quit");
 
 #ifdef COLOR_TOGGLE
@@ -262,13 +411,13 @@ void showTableSelectionScreen()
         }
 #endif
 
-        shownCursor = !clientState.tables.count;
+        shownCursor = !pageRows;
 
         clearCommonInput();
-        while (!input.trigger || !clientState.tables.count)
+        while (!input.trigger || !pageRows)
         {
 
-            if (clientState.tables.count)
+            if (pageRows)
             {
                 drawIcon(LMAR - 2, 9 + tableIndex * 2, blinkCursor < 50 ? ICON_MARK : ICON_MARK_ALT);
             }
@@ -284,6 +433,7 @@ void showTableSelectionScreen()
                 if (!restoreScreen())
                 {
                     resetScreen();
+                    redrawScreen = true;
                     break;
                 }
             }
@@ -297,6 +447,7 @@ void showTableSelectionScreen()
                 cycleNextColor();
                 savePrefs();
 #ifdef COLOR_CYCLE_REQUIRES_REDRAW
+                redrawScreen = true;
                 break;
 #endif
             }
@@ -310,21 +461,32 @@ void showTableSelectionScreen()
             {
                 showPlayerNameScreen();
                 resetScreen();
+                redrawScreen = true;
                 break;
             }
             else if (input.key == 'q' || input.key == 'Q')
             {
+                flushAppKeys();
                 quit();
+            }
+            else if (input.dirX > 0 ? moreTables : input.dirX < 0 && tableOffset)
+            {
+                // Show the next or previous page of tables
+                tableOffset += input.dirX > 0 ? TABLES_PAGE : -TABLES_PAGE;
+                drawBlank(LMAR - 2, 9 + tableIndex * 2);
+                tableIndex = 0;
+                soundCursor();
+                break;
             } /*else if (input.key != 0) {
                 itoa(input.key, tempBuffer, 10);
                 drawStatusText(tempBuffer);
             }*/
 
-            if (!shownCursor || (clientState.tables.count > 0 && input.dirY))
+            if (!shownCursor || (pageRows > 0 && input.dirY))
             {
 
                 // Visually unselect old table
-                table = &clientState.tables.table[tableIndex];
+                table = &clientState.tables.table[pageStart + tableIndex];
                 j = table->name[0]; // Reference table so cmoc 0.1.96 optimizer does not corrupt memory
                 j = 9 + tableIndex * 2;
 
@@ -333,11 +495,11 @@ void showTableSelectionScreen()
                 drawTextAlt(RMAR - 5, j, table->players);
 
                 // Move table index to new table
-                tableIndex = (input.dirY + tableIndex + clientState.tables.count) % clientState.tables.count;
+                tableIndex = (input.dirY + tableIndex + pageRows) % pageRows;
 
                 // Visually select new table
 
-                table = &clientState.tables.table[tableIndex];
+                table = &clientState.tables.table[pageStart + tableIndex];
                 j = table->name[0]; // Reference table so cmoc 0.1.96 optimizer does not corrupt memory
                 j = 9 + tableIndex * 2;
 
@@ -360,10 +522,11 @@ void showTableSelectionScreen()
 
             // Clear screen and write server name
             resetScreen();
-            centerText(15, clientState.tables.table[tableIndex].name);
+            table = &clientState.tables.table[pageStart + tableIndex];
+            centerText(15, table->name);
 
             strcpy(query, "?table=");
-            strcat(query, clientState.tables.table[tableIndex].table);
+            strcat(query, table->table);
 
             // Combine server endpoint and query for final base url
             strcpy(tempBuffer, serverEndpoint);
@@ -375,6 +538,9 @@ void showTableSelectionScreen()
     }
 
     centerTextAlt(17, "connecting to server");
+
+    // Save settings changed on this screen, and the table joined, in case of reboot
+    flushAppKeys();
     progressAnim(19);
 
     // Append player name to query
@@ -394,7 +560,9 @@ void showTableSelectionScreen()
     // Clear gamefield
     memset(state.gamefield, 0, sizeof(state.gamefield));
 
-    // Join table
+    // Join table, keeping the connection open while at the table.
+    // This also prepares the request url for the final query
+    openChannel();
     apiCall("state");
 
     // Reduce wait count for an immediate call
@@ -426,6 +594,7 @@ void showInGameMenuScreen()
         drawBox(INGAME_MENU_X - 2, HEIGHT / 2 - 5, 19, y - (HEIGHT / 2 - 5) + 1);
 
         centerTextAlt(HEIGHT - 2, "press TRIGGER/SPACE to close");
+        presentScreen();
 
         // centerTextAlt(y + 6, tempBuffer);
         clearCommonInput();
@@ -462,14 +631,17 @@ void showInGameMenuScreen()
                 showHelpScreen();
             case 'q':
             case 'Q':
+                keepScreen();
                 resetScreen();
                 centerText(10, "please wait");
 
                 //  Clear server app key in case of reboot
                 write_appkey(AK_LOBBY_CREATOR_ID, AK_LOBBY_APP_ID, AK_LOBBY_KEY_SERVER, 0, (char *)"");
+                flushAppKeys();
 
                 // Inform server player is leaving
                 apiCall("leave");
+                closeChannel();
 
                 progressAnim(12);
 
@@ -483,12 +655,13 @@ void showInGameMenuScreen()
     }
 
     // Show game screen again before returning
-
+    flushAppKeys();
     clearCommonInput();
 
     state.inGame = true;
     if ((!state.drawBoard && !restoreScreen()) || state.drawBoard)
     {
+        keepScreen();
         clearRenderState();
         processStateChange();
     }
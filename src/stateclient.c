@@ -7,11 +7,54 @@
 
 #include "misc.h"
 #include "stateclient.h"
+#include "telemetry.h"
 #include "fujinet-network.h"
 
 // Internal to this file
-static char url[160];
-char *requestedMove;
+static char url[200];
+
+// Parts of the request url that only change when joining a table (see prepareRequests).
+// url keeps the prefix, so each request only splices in the path and what follows
+static uint8_t prefixLen, tailLen, urlLen;
+static char tail[64];
+
+static uint16_t stateToken, tablesToken;
+static bool stateTokenValid, tablesTokenValid;
+static uint8_t viewPollHint;
+
+// Requests queued by sendMove, sent in order ahead of state polls
+static char requestQueue[REQUEST_QUEUE_MAX][REQUEST_PATH_LEN];
+static uint8_t requestCount;
+
+// Server endpoints found by selectEndpoint, fastest first
+static char endpointList[128];
+static char *endpoints[ENDPOINT_MAX];
+static uint8_t endpointCount, endpointIndex;
+
+// Keep-alive channel. Plain http endpoints are reached over a raw TCP socket on
+// a second network unit, sending HTTP/1.1 requests so one connection serves every
+// request while at a table. Other endpoints (e.g. https) open/close per request.
+static char channel[60];
+static char *channelHost, *channelPath;
+static uint8_t channelHostLen;
+static bool channelOpen;
+static uint8_t rx[32];
+static char line[24];
+
+// Request in flight, read a chunk at a time by apiCallPump
+#define NETWORK_EOF 136
+#define REQ_IDLE 0
+#define REQ_HEADERS 1
+#define REQ_BODY 2
+static uint8_t reqState, reqResult, lineLen, lineCount, firstByte, transferErrors;
+static uint16_t reqLen, reqWait, reqFrames, reqTimeout, reqBudget, contentLength;
+static uint8_t *reqBuf;
+static char reqPath[40];
+static bool reqRetried, isStatePoll, isTables, isLongPoll, statusOk, lengthKnown, chunked;
+
+// Header of the last state, to compare against while a poll is read
+static uint8_t prevHeader[STATE_HEADER_LEN];
+static bool headerCheck, sinceSupported, waitSupported;
 
 #ifdef CUSTOM_FUJINET_CALLS
 // Optional: This would be implemented in platform-specific code for emulators, etc
@@ -19,68 +62,937 @@ int16_t custom_network_call(char *url, uint8_t *buffer, uint16_t max_len);
 #endif
 
 /*
- * @brief Makes an Api call, returning true if valid payload received
- * Returns API_CALL_*:
- *  1 - successfully received a payload
- *  2 - async - received payload, still in process, call for more data
- *  0 - error - aborted
+ * @brief Returns a Fletcher-16 style token of the received payload.
+ * For game states, moveTime is skipped, since it ticks down every second without affecting the board.
  */
-uint8_t apiCall(const char *path)
+uint16_t calcStateToken(uint16_t len)
 {
-    static int16_t read;
+    static uint8_t sum1, sum2, *ptr, *moveTime;
 
-    strcpy(url, "n:");
-    strcat(url, serverEndpoint);
-    strcat(url, path);
-    strcat(url, query);
-    strcat(url, query[0] ? "&bin=1&v=" API_CLIENT_VERSION : "?bin=1&v=" API_CLIENT_VERSION);
+    sum1 = sum2 = 0;
+    ptr = &clientState.firstByte;
+    moveTime = isTables ? NULL : &clientState.game.moveTime;
 
-    // Allow platform-specific override (e.g. for mocking network calls in emulator)
+    while (len--)
+    {
+        if (ptr != moveTime)
+        {
+            sum1 += *ptr;
+            sum2 += sum1;
+        }
+        ptr++;
+    }
+
+    return (uint16_t)sum2 << 8 | sum1;
+}
+
+#ifdef COMPACT_STATE
+/*
+ * @brief Expands compact v3 player records in place to the v2 layout. Returns the expanded length.
+ * The records are first moved to the end of the buffer, so expanding never overwrites unread input.
+ */
+uint16_t expandCompactState(uint16_t len)
+{
+    static uint8_t *src, *dest, *end, i, j, mask, b, run;
+    static uint16_t headerLen;
+
+    clientState.game.playerCount &= ~COMPACT_FLAG;
+    headerLen = (uint16_t)((uint8_t *)clientState.game.players - &clientState.firstByte);
+    if (len <= headerLen)
+        return len;
+
+    len -= headerLen;
+    end = (uint8_t *)(&clientState.game + 1);
+    src = (uint8_t *)clientState.game.players + len;
+    dest = end;
+    while (len--)
+        *--dest = *--src;
+
+    src = dest;
+    dest = (uint8_t *)clientState.game.players;
+
+    for (i = 0; i < PLAYER_MAX && src < end; i++)
+    {
+        // Name and status are sent as is
+        for (j = 0; j < 10; j++)
+            *dest++ = *src++;
+
+        mask = *src++;
+        run = 0;
+
+        for (j = 0; j < 25; j++)
+        {
+            if (run)
+            {
+                run--;
+                b = 0;
+            }
+            else
+            {
+                b = *src++;
+                if (!b && (mask & COMPACT_RLE))
+                    run = *src++ - 1;
+            }
+
+            dest[0] = b & 3;
+            dest[1] = (b >> 2) & 3;
+            dest[2] = (b >> 4) & 3;
+            dest[3] = b >> 6;
+            dest += 4;
+        }
+
+        for (j = 0; j < 5; j++)
+        {
+            *dest++ = mask & 1;
+            mask >>= 1;
+        }
+    }
+
+    return (uint16_t)(dest - &clientState.firstByte);
+}
+#endif
+
+/// @brief Applies the changes of a spectator reply (see VIEW_DELTA) to the last state, which is still in place
+void applyViewDelta()
+{
+    static uint8_t *src, *end, i, j, count, mask;
+    static Player *player;
+
+    clientState.game.playerCount &= ~VIEW_DELTA;
+    src = (uint8_t *)clientState.game.prompt;
+    end = src + sizeof(clientState.game.prompt);
+    viewPollHint = *src++;
+
+    for (i = 0; i < clientState.game.playerCount && src + 3 <= end; i++)
+    {
+        player = &clientState.game.players[i];
+        player->playerStatus = *src++;
+
+        mask = *src++;
+        for (j = 0; j < 5; j++)
+        {
+            player->shipsLeft[j] = mask & 1;
+            mask >>= 1;
+        }
+
+        for (count = *src++; count && src + 2 <= end; count--, src += 2)
+        {
+            if (src[0] < 100)
+                player->gamefield[src[0]] = src[1];
+        }
+    }
+
+    // The prompt is only shown outside of play, when full states are sent
+    clientState.game.prompt[0] = 0;
+}
+
+/// @brief Appends the 4 digit hex representation of value to the string
+void appendHex(char *dest, uint16_t value)
+{
+    static uint8_t i, c;
+
+    dest += strlen(dest);
+    for (i = 0; i < 4; i++)
+    {
+        c = (uint8_t)(value >> 12);
+        *dest++ = c < 10 ? '0' + c : 'a' - 10 + c;
+        value <<= 4;
+    }
+    *dest = 0;
+}
+
+/*
+ * @brief Builds the request for path into url. For the keep-alive channel this is
+ * the full HTTP/1.1 request, otherwise the devicespec
+ */
+void buildRequest(const char *path, bool isStatePoll)
+{
+    static char *end;
+    static uint8_t len;
+    static bool since;
+
+    // Splice the path between the prepared prefix and tail
+    len = (uint8_t)strlen(path);
+    end = url + prefixLen;
+    memcpy(end, path, len);
+    end += len;
+    memcpy(end, tail, tailLen);
+
+    // The path may carry its own parameters (e.g. table list paging)
+    if (*end == '?' && strchr(path, '?'))
+        *end = '&';
+    end += tailLen;
+
+    // Ask the server to only send the full state (or table list) if it changed since the
+    // last one received. Once a "not modified" reply shows the server understands this,
+    // a state poll is also held open until the state changes
+    since = isStatePoll && stateTokenValid;
 #ifdef CUSTOM_FUJINET_CALLS
-    read = custom_network_call(url, &clientState.firstByte, sizeof(clientState.game));
+    // Custom calls block until the reply, so a held poll would freeze the game
+    isLongPoll = false;
 #else
-    if (network_open(url, OPEN_MODE_HTTP_GET, OPEN_TRANS_NONE))
+    isLongPoll = since && waitSupported;
+#endif
+    if (since || (isTables && tablesTokenValid))
     {
-        return API_CALL_ERROR;
+        memcpy(end, "&since=", 7);
+        end[7] = 0;
+        appendHex(end, since ? stateToken : tablesToken);
+        end += 11;
     }
 
-    read = network_read(url, &clientState.firstByte, sizeof(clientState.game));
-    network_close(url);
-#endif
+    if (isLongPoll)
+    {
+        memcpy(end, "&wait=" LONG_POLL_WAIT, sizeof("&wait=" LONG_POLL_WAIT) - 1);
+        end += sizeof("&wait=" LONG_POLL_WAIT) - 1;
+    }
+
+    // Spectators only need the changes to each board
+    if (since && clientState.game.playerStatus == PLAYER_STATUS_VIEWING && clientState.game.status != STATUS_LOBBY)
+    {
+        memcpy(end, "&view=1", 7);
+        end += 7;
+    }
+
+    if (channelOpen)
+    {
+        memcpy(end, " HTTP/1.1\r\nHost: ", 17);
+        end += 17;
+        memcpy(end, channelHost, channelHostLen);
+        end += channelHostLen;
+        memcpy(end, "\r\n\r\n", 4);
+        end += 4;
+    }
+
+    *end = 0;
+    urlLen = (uint8_t)(end - url);
+}
+
+void prepareRequests()
+{
+    if (channelOpen)
+    {
+        strcpy(url, "GET ");
+        strcat(url, channelPath);
+    }
+    else
+    {
+        strcpy(url, "n:");
+        strcat(url, serverEndpoint);
+    }
+    prefixLen = (uint8_t)strlen(url);
+
+    strcpy(tail, query);
+    strcat(tail, query[0] ? "&bin=1&v=" API_CLIENT_VERSION : "?bin=1&v=" API_CLIENT_VERSION);
+    tailLen = (uint8_t)strlen(tail);
+}
+
+/// @brief Opens the keep-alive channel to the server endpoint. Returns true if open
+bool openChannel()
+{
+    static uint8_t i;
+
+    closeChannel();
+
+    // Raw sockets can only reach plain http endpoints
+    if (strncmp(serverEndpoint, "http://", 7))
+        return false;
+
+    // Split "http://host[:port]/path" into host and path
+    channelHost = serverEndpoint + 7;
+    channelPath = strchr(channelHost, '/');
+    if (!channelPath)
+        return false;
+
+    channelHostLen = (uint8_t)(channelPath - channelHost);
+    if (channelHostLen + 16 > sizeof(channel))
+        return false;
+
+    strcpy(channel, "n2:tcp://");
+    i = (uint8_t)strlen(channel);
+    memcpy(channel + i, channelHost, channelHostLen);
+    channel[i + channelHostLen] = 0;
+
+    // TCP requires a port
+    if (!strchr(channel + i, ':'))
+        strcat(channel, ":80");
+
+    channelOpen = !network_open(channel, OPEN_MODE_RW, OPEN_TRANS_NONE);
+    if (channelOpen)
+        prepareRequests();
+
+    return channelOpen;
+}
+
+/// @brief Collects the endpoints from the AK_KEY_ENDPOINTS appkey, followed by serverEndpoint
+void loadEndpoints()
+{
+    static uint8_t i, len;
+
+    endpointCount = 0;
+    len = (uint8_t)read_appkey(AK_CREATOR_ID, AK_APP_ID, AK_KEY_ENDPOINTS, endpointList);
+
+    for (i = 0; i < len; i++)
+    {
+        if (endpointList[i] == ' ')
+            endpointList[i] = 0;
+    }
+
+    // Endpoints too long for serverEndpoint are skipped
+    for (i = 0; i < len && endpointCount < ENDPOINT_MAX - 1; i++)
+    {
+        if (endpointList[i] && (!i || !endpointList[i - 1]) && strlen(endpointList + i) < sizeof(serverEndpoint) &&
+            strcmp(endpointList + i, serverEndpoint))
+            endpoints[endpointCount++] = endpointList + i;
+    }
+
+    if (len + 1 + strlen(serverEndpoint) < sizeof(endpointList))
+    {
+        endpoints[endpointCount] = endpointList + len + 1;
+        strcpy(endpoints[endpointCount++], serverEndpoint);
+    }
+}
+
+void selectEndpoint()
+{
+    static uint8_t i, j, frames, result;
+    static uint16_t rtt[ENDPOINT_MAX], t;
+    static char *e;
+
+    loadEndpoints();
+    endpointIndex = 0;
+    if (endpointCount < 2)
+        return;
+
+    for (i = 0; i < endpointCount; i++)
+    {
+        e = endpoints[i];
+        strcpy(serverEndpoint, e);
+        prepareRequests();
+
+        // Time a small request in frames, giving up on slow or unreachable endpoints.
+        // getTime is not a clock on every platform, so the frames waited are the measure.
+        t = 0xFFFF;
+        result = apiCallStart(ENDPOINT_PROBE_PATH);
+        for (frames = 0; result == API_CALL_PENDING && frames < ENDPOINT_PROBE_TIMEOUT; frames++)
+        {
+            waitvsync();
+            result = apiCallPump();
+        }
+
+        if (result == API_CALL_PENDING)
+            apiCallCancel();
+        else if (result != API_CALL_ERROR)
+            t = frames;
+
+        // Keep the endpoints probed so far sorted, fastest first
+        for (j = i; j && rtt[j - 1] > t; j--)
+        {
+            rtt[j] = rtt[j - 1];
+            endpoints[j] = endpoints[j - 1];
+        }
+        rtt[j] = t;
+        endpoints[j] = e;
+    }
+
+    strcpy(serverEndpoint, endpoints[0]);
+    prepareRequests();
+}
+
+bool nextEndpoint()
+{
+    if (endpointCount < 2)
+        return false;
+
+    endpointIndex = (endpointIndex + 1) % endpointCount;
+    strcpy(serverEndpoint, endpoints[endpointIndex]);
+
+    // Reconnect, which also prepares the request url for the new endpoint
+    openChannel();
+    return true;
+}
+
+void closeChannel()
+{
+    if (channelOpen)
+    {
+        network_close(channel);
+        channelOpen = false;
+    }
+
+    prepareRequests();
+}
+
+/*
+ * @brief Sends the current request, either over the keep-alive channel or by
+ * opening a new connection. Returns true if sent
+ */
+bool sendRequest()
+{
+    buildRequest(reqPath, isStatePoll);
+
+    reqLen = reqWait = reqFrames = contentLength = 0;
+    reqTimeout = isLongPoll ? LONG_POLL_TIMEOUT : API_CALL_TIMEOUT;
+
+    // Keep up with the link (125 bytes per second per kbps), so a fast one is not held back
+    reqBudget = (uint16_t)getTransferKbps() * 125 / getJiffiesPerSecond();
+    if (reqBudget < API_FRAME_BUDGET)
+        reqBudget = API_FRAME_BUDGET;
+    lineLen = lineCount = 0;
+    statusOk = lengthKnown = chunked = false;
+
+    if (channelOpen)
+    {
+        reqState = REQ_HEADERS;
+        return !network_write(channel, (uint8_t *)url, urlLen);
+    }
+
+    reqState = REQ_BODY;
+    return !network_open(url, OPEN_MODE_HTTP_GET, OPEN_TRANS_NONE);
+}
+
+/// @brief Completes the current request with the bytes read (negative on error). Returns API_CALL_*
+uint8_t finishRequest(int16_t read)
+{
+    static uint16_t token;
+    static uint8_t rows;
+
+    if (reqState != REQ_IDLE && !channelOpen)
+        network_close(url);
+
+    reqState = REQ_IDLE;
+
+    // Only errors in a row count towards a slower transfer speed
+    if (read > 0)
+        transferErrors = 0;
+
+    // Other calls (moves, leaving, tables) always expect a full reply next time
+    if (!isStatePoll)
+        stateTokenValid = false;
+
+    // Any other reply replaces the table list
+    if (!isTables)
+        tablesTokenValid = false;
 
     // If no bytes read, set first byte of clientState to 0, which is the number of tables or players
     if (read <= 0)
     {
         clientState.firstByte = 0;
-        return API_CALL_ERROR;
+        tablesTokenValid = false;
+        return reqResult = API_CALL_ERROR;
     }
 
-    return API_CALL_SUCCESS;
+    if ((isStatePoll || isTables) && read == 1 && clientState.firstByte == API_NOT_MODIFIED)
+    {
+        sinceSupported |= isStatePoll;
+        waitSupported |= isStatePoll;
+        clientState.firstByte = firstByte;
+        return reqResult = API_CALL_NOCHANGE;
+    }
+
+    if (isTables)
+    {
+        token = calcStateToken((uint16_t)read);
+
+        // List only the tables received in full that fit, whatever the count says
+        rows = (uint8_t)(((uint16_t)read - 1) / sizeof(Table));
+        if (rows > sizeof(clientState.tables.table) / sizeof(Table))
+            rows = sizeof(clientState.tables.table) / sizeof(Table);
+        if ((clientState.tables.count & ~TABLES_MORE) > rows)
+            clientState.tables.count = (clientState.tables.count & TABLES_MORE) | rows;
+
+        if (tablesTokenValid && token == tablesToken)
+            return reqResult = API_CALL_NOCHANGE;
+
+        tablesToken = token;
+        tablesTokenValid = true;
+    }
+    else
+    {
+        state.stateFrames = 0;
+
+#ifdef COMPACT_STATE
+        if (clientState.game.playerCount & COMPACT_FLAG)
+            read = (int16_t)expandCompactState((uint16_t)read);
+#endif
+
+        // Servers that do not support "since" still send the full state,
+        // so compare tokens to avoid re-rendering an unchanged state
+        token = calcStateToken((uint16_t)read);
+        if (isStatePoll && stateTokenValid && token == stateToken)
+            return reqResult = API_CALL_NOCHANGE;
+
+        stateToken = token;
+        stateTokenValid = true;
+
+        // The server keeps the state this token stands for, so it is applied after taking the token
+        viewPollHint = 0;
+        if (isStatePoll && (clientState.game.playerCount & VIEW_DELTA))
+        {
+            sinceSupported = true;
+            applyViewDelta();
+        }
+    }
+
+    return reqResult = API_CALL_SUCCESS;
 }
 
-void sendMove(char *move)
+/*
+ * @brief Returns true if the header read so far matches the last state, meaning no move was made
+ * since. moveTime and the compact flag are ignored.
+ */
+bool headerUnchanged()
 {
-    if (move != NULL)
+    static uint8_t i, *ptr;
+
+    ptr = &clientState.firstByte;
+    if ((ptr[0] & ~COMPACT_FLAG) != prevHeader[0] || clientState.game.status == STATUS_LOBBY)
+        return false;
+
+    for (i = 1; i < STATE_HEADER_LEN; i++)
+    {
+        if (ptr[i] != prevHeader[i] && &ptr[i] != &clientState.game.moveTime)
+            return false;
+    }
+
+    return true;
+}
+
+/// @brief Handles a failed send or read. If the keep-alive channel dropped, retries over a new connection
+uint8_t failRequest()
+{
+    if (channelOpen)
+    {
+        // Reconnect and retry once, then fall back to a request per call until the next table join
+        if (reqRetried || !openChannel())
+            closeChannel();
+
+        // A move may have reached the server already, so only polls are sent again
+        reqRetried = true;
+        if ((isStatePoll || isTables) && sendRequest())
+            return API_CALL_PENDING;
+    }
+
+    return finishRequest(-1);
+}
+
+/// @brief Handles a reply on the keep-alive channel that can not be framed, so the rest can not be skipped
+uint8_t rejectReply()
+{
+    // The link itself works, so start over on a fresh connection and keep using it
+    openChannel();
+    return finishRequest(-1);
+}
+
+/// @brief Handles a failed status or read, which may come from a link speed that is not reliable
+uint8_t transferError()
+{
+    if (++transferErrors == TRANSFER_FALLBACK_ERRORS)
+    {
+        transferErrors = 0;
+        fallbackTransferSpeed();
+    }
+
+    return failRequest();
+}
+
+/*
+ * @brief Parses a chunk of response headers in rx. Once the blank line ending
+ * the headers is found, the rest of the chunk is the start of the body
+ */
+void parseHeaders(uint8_t len)
+{
+    static uint8_t i, j;
+    static char c;
+
+    for (i = 0; i < len; i++)
+    {
+        c = rx[i];
+        if (c == '\r')
+            continue;
+
+        if (c != '\n')
+        {
+            // Only the start of each line matters, lowercased
+            if (lineLen < sizeof(line) - 1)
+                line[lineLen++] = c >= 'A' && c <= 'Z' ? c + 32 : c;
+            continue;
+        }
+
+        if (!lineLen)
+        {
+            i++;
+            reqState = REQ_BODY;
+            reqLen = len - i;
+            if (reqLen > contentLength)
+                reqLen = contentLength;
+            memcpy(reqBuf, rx + i, reqLen);
+            return;
+        }
+
+        line[lineLen] = 0;
+        if (!lineCount++)
+        {
+            // Status line, e.g. "http/1.1 200 ok"
+            statusOk = line[9] == '2';
+        }
+        else if (!strncmp(line, "content-length:", 15))
+        {
+            lengthKnown = true;
+            for (j = 15; j < lineLen; j++)
+            {
+                if (line[j] >= '0' && line[j] <= '9')
+                    contentLength = contentLength * 10 + line[j] - '0';
+            }
+        }
+        else if (!strncmp(line, "transfer-encoding:", 18))
+        {
+            // Only a Content-Length body can be read to its end
+            chunked = true;
+        }
+        lineLen = 0;
+    }
+}
+
+uint8_t apiCallStart(const char *path)
+{
+    apiCallCancel();
+
+    // A table list token only applies to the same page
+    if (strcmp(path, reqPath))
+        tablesTokenValid = false;
+
+    strcpy(reqPath, path);
+    isStatePoll = strcmp(path, "state") == 0;
+    isTables = strncmp(path, "tables", 6) == 0;
+    reqBuf = &clientState.firstByte;
+    reqRetried = false;
+
+    // Keep the first byte in case the reply is a single "not modified" byte
+    firstByte = clientState.firstByte;
+
+    // Keep the header of the last state, so a one-shot poll can stop reading once the new
+    // header shows nothing changed. Not needed if the server replies "not modified" itself,
+    // and the keep-alive channel would have to reconnect
+    headerCheck = isStatePoll && stateTokenValid && !sinceSupported && !channelOpen;
+    if (headerCheck)
+        memcpy(prevHeader, &clientState.firstByte, STATE_HEADER_LEN);
+
+    // Allow platform-specific override (e.g. for mocking network calls in emulator)
+#ifdef CUSTOM_FUJINET_CALLS
+    buildRequest(reqPath, isStatePoll);
+    return finishRequest(custom_network_call(url, reqBuf, sizeof(clientState.game)));
+#else
+    if (!sendRequest())
+        return failRequest();
+
+    return reqResult = API_CALL_PENDING;
+#endif
+}
+
+uint8_t apiCallPump()
+{
+    static uint16_t bw, left;
+    static int16_t read;
+    static uint8_t conn, err;
+    static char *spec;
+
+    if (reqState == REQ_IDLE)
+        return reqResult;
+
+    spec = channelOpen ? channel : url;
+    reqFrames++;
+
+    if (network_status(spec, &bw, &conn, &err))
+        return transferError();
+
+    if (!bw)
+    {
+        // A new connection is closed by the server at the end of the body
+        if (reqState == REQ_BODY && !channelOpen && (!conn || err == NETWORK_EOF))
+            return finishRequest((int16_t)reqLen);
+
+        if ((channelOpen && !conn) || ++reqWait > reqTimeout)
+            return failRequest();
+
+        return API_CALL_PENDING;
+    }
+
+    reqWait = 0;
+    if (bw > reqBudget)
+        bw = reqBudget;
+
+    if (reqState == REQ_HEADERS)
+    {
+        if (bw > sizeof(rx))
+            bw = sizeof(rx);
+
+        if ((read = network_read_nb(channel, rx, bw)) <= 0)
+            return transferError();
+
+        parseHeaders((uint8_t)read);
+        if (reqState == REQ_HEADERS)
+            return API_CALL_PENDING;
+
+        // The rest of an unexpected response cannot be skipped, so give up on this connection
+        if (!statusOk || !lengthKnown || chunked || contentLength > sizeof(clientState.game))
+            return rejectReply();
+    }
+    else
+    {
+        // Never read past the end of the buffer, or into the next response
+        left = (channelOpen ? contentLength : sizeof(clientState.game)) - reqLen;
+
+        // Read only the header until it has been checked
+        if (headerCheck)
+            left = STATE_HEADER_LEN - reqLen;
+
+        if (bw > left)
+            bw = left;
+
+        if (bw)
+        {
+            if ((read = network_read_nb(spec, reqBuf + reqLen, bw)) < 0)
+                return transferError();
+
+            reqLen += (uint16_t)read;
+        }
+
+        if (headerCheck && reqLen == STATE_HEADER_LEN)
+        {
+            headerCheck = false;
+
+            // The rest of the last state is still in place, so stop here
+            if (headerUnchanged())
+            {
+                network_close(url);
+                reqState = REQ_IDLE;
+                clientState.game.playerCount &= ~COMPACT_FLAG;
+                state.stateFrames = 0;
+                return reqResult = API_CALL_NOCHANGE;
+            }
+        }
+    }
+
+    // Done once the body (or buffer) is full
+    if (reqLen == (channelOpen ? contentLength : sizeof(clientState.game)))
+        return finishRequest((int16_t)reqLen);
+
+    return API_CALL_PENDING;
+}
+
+void apiCallCancel()
+{
+    if (reqState == REQ_IDLE)
+        return;
+
+    // The keep-alive channel is mid-response, so start over on a fresh connection
+    if (channelOpen)
+        openChannel();
+    else
+        network_close(url);
+
+    reqState = REQ_IDLE;
+    reqResult = API_CALL_ERROR;
+
+    // A partial reply may have been read, so ask for the full state next time
+    stateTokenValid = tablesTokenValid = false;
+}
+
+bool apiCallBusy()
+{
+    return reqState != REQ_IDLE;
+}
+
+uint8_t apiCallFinish()
+{
+    static uint8_t result;
+
+    while ((result = apiCallPump()) == API_CALL_PENDING)
+        waitvsync();
+
+    return result;
+}
+
+uint8_t apiCall(const char *path)
+{
+    static uint8_t result;
+
+    // Let a move in flight complete, but cancel a routine state poll
+    if (isStatePoll)
+        apiCallCancel();
+
+    apiCallFinish();
+
+    // Blocking calls join or leave a table, so queued moves no longer apply
+    requestCount = 0;
+
+    // A reply completed here is never rendered, so ask for the full state next time
+    stateTokenValid = false;
+
+    result = apiCallStart(path);
+    while (result == API_CALL_PENDING)
+    {
+        waitvsync();
+        result = apiCallPump();
+    }
+
+    return result;
+}
+
+/// @brief Translates API_CALL_* to STATE_UPDATE_*
+uint8_t translateResult(uint8_t result)
+{
+    switch (result)
+    {
+    case API_CALL_SUCCESS:
+        return STATE_UPDATE_CHANGE;
+    case API_CALL_NOCHANGE:
+        return STATE_UPDATE_NOCHANGE;
+    case API_CALL_PENDING:
+        return STATE_UPDATE_PENDING;
+    }
+
+    return STATE_UPDATE_ERROR;
+}
+
+void schedulePoll(uint8_t update, uint8_t failedCalls)
+{
+    static uint16_t wait;
+
+    // Send the next queued request right away
+    if (requestCount)
+    {
         state.apiCallWait = 0;
+        return;
+    }
+
+    if (update == STATE_UPDATE_ERROR)
+    {
+        // Back off exponentially, with up to a second of jitter
+        wait = POLL_NORMAL << (failedCalls - 1);
+        if (wait > POLL_ERROR_MAX)
+            wait = POLL_ERROR_MAX;
+
+        state.apiCallWait = wait + getRandomNumber(60);
+        return;
+    }
 
-    requestedMove = move;
+    if (viewPollHint && clientState.game.playerStatus == PLAYER_STATUS_VIEWING)
+    {
+        // Spectating, at the interval the server asked for
+        wait = (uint16_t)viewPollHint * getJiffiesPerSecond() / 4;
+    }
+    else if (isLongPoll && (update == STATE_UPDATE_CHANGE || reqFrames > POLL_NORMAL) &&
+        (clientState.game.activePlayer != 0 || clientState.game.status < STATUS_GAMESTART))
+    {
+        // The server held the request until something changed, so ask again right away.
+        // Servers without long poll support reply at once, and fall through to the normal intervals
+        wait = 0;
+    }
+    else if (!isStatePoll && !isTables)
+    {
+        // Reply to this player's move. The next player is likely to move soon
+        wait = POLL_FAST;
+    }
+    else if (clientState.game.status == STATUS_LOBBY)
+    {
+        wait = state.countdownStarted ? POLL_FAST : POLL_NORMAL;
+    }
+    else if (clientState.game.status == STATUS_GAMEOVER ||
+             clientState.game.playerStatus == PLAYER_STATUS_VIEWING ||
+             clientState.game.playerStatus == PLAYER_STATUS_DEFEATED)
+    {
+        wait = POLL_SLOW;
+    }
+    else
+    {
+        wait = POLL_NORMAL;
+    }
+
+    state.apiCallWait = wait + getRandomNumber(POLL_JITTER);
+}
+
+bool sendMove(const char *move)
+{
+    // Two ready toggles in a row cancel out
+    if (requestCount && !strcmp(move, "ready") && !strcmp(requestQueue[requestCount - 1], "ready"))
+    {
+        requestCount--;
+        return true;
+    }
+
+    // A queued move is never replaced, so the new one is refused until there is room
+    if (requestCount == REQUEST_QUEUE_MAX)
+        return false;
+
+    strncpy(requestQueue[requestCount], move, REQUEST_PATH_LEN - 1);
+    requestCount++;
+
+    state.apiCallWait = 0;
+    return true;
+}
+
+/// @brief Moves the oldest queued request into tempBuffer
+void popRequest()
+{
+    static uint8_t i;
+
+    strcpy(tempBuffer, requestQueue[0]);
+    requestCount--;
+    for (i = 0; i < requestCount; i++)
+        strcpy(requestQueue[i], requestQueue[i + 1]);
+}
+
+void flushRequests()
+{
+    // Let a move in flight complete, but cancel a routine state poll
+    if (isStatePoll)
+        apiCallCancel();
+
+    apiCallFinish();
+
+    // Their replies are never rendered, and a reply to a move leaves the state
+    // token invalid, so the next poll brings the full state
+    while (requestCount)
+    {
+        popRequest();
+        apiCallStart(tempBuffer);
+        apiCallFinish();
+    }
 }
 
 uint8_t getStateFromServer()
 {
+    static uint8_t result;
+
+    // A queued request does not wait on a routine state poll, e.g. one held open by the server
+    if (requestCount && isStatePoll && apiCallBusy())
+        apiCallCancel();
+
+    telemetryMark();
 
-    if (requestedMove)
+    // Read the next chunk of the request in flight
+    if (apiCallBusy())
     {
-        // Copy requested move to the temp buffer it is not already one and the same
-        if (requestedMove != tempBuffer)
-            strcpy(tempBuffer, requestedMove);
+        result = apiCallPump();
+        telemetryFrames();
+        if (result != API_CALL_PENDING)
+            telemetryPoll(result, reqLen, reqFrames, isLongPoll);
 
-        requestedMove = NULL;
+        return translateResult(result);
     }
+
+    // Queued requests go first. Their reply is the new state, so no poll is needed alongside
+    if (requestCount)
+        popRequest();
     else
-    {
         strcpy(tempBuffer, "state");
-    }
 
-    return apiCall(tempBuffer);
+    result = apiCallStart(tempBuffer);
+    telemetryFrames();
+    if (result != API_CALL_PENDING)
+        telemetryPoll(result, reqLen, reqFrames, isLongPoll);
+
+    return translateResult(result);
 }
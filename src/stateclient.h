@@ -11,14 +11,119 @@
 #define API_CALL_ERROR (0)
 #define API_CALL_SUCCESS (1)
 #define API_CALL_PENDING (2)
+#define API_CALL_NOCHANGE (3)
+
+// Frames to wait without receiving data before a call fails
+#define API_CALL_TIMEOUT 600
+
+// Bytes read per frame while a call is in flight, so the UI keeps animating. Raised to what
+// the link delivers in a frame when getTransferKbps knows it. Set in [platform]/vars.h to override
+#ifndef API_FRAME_BUDGET
+#define API_FRAME_BUDGET 64
+#endif
+
+// Seconds the server may hold a state poll open until the state changes.
+// LONG_POLL_TIMEOUT must allow for the full hold
+#define LONG_POLL_WAIT "20"
+#define LONG_POLL_TIMEOUT (API_CALL_TIMEOUT + 20 * 60)
+
+// Bytes of a game reply up to and including lastAttackPos. Read first, so a poll can
+// stop early when they match the last state
+#define STATE_HEADER_LEN 39
+
+// v3 replies set this bit in playerCount when the player records are compact.
+// A compact record is name[9] status(1) mask(1) gamefield[25 or less]:
+//   mask     - bits 0-4 are shipsLeft[0-4], bit 7 set if the gamefield is run-length encoded
+//   gamefield - 2 bits per cell, 4 cells per byte starting at the low bits. When run-length
+//              encoded, a 0 byte is followed by the count of 0 bytes in that run
+#define COMPACT_FLAG 0x40
+#define COMPACT_RLE 0x80
+
+// Spectators ask for "view" state polls. While a game is in play, the server may reply with
+// only the changes since the "since" token, setting this bit in playerCount. The reply is the
+// usual header, with the changes in place of the prompt:
+//   prompt[0] - suggested poll interval in quarter seconds (0 for none)
+//   then per player: status, ship mask (bits 0-4 are shipsLeft[0-4]), count, count x (pos, value)
+#define VIEW_DELTA 0x20
+
+// Set in the count of a table list page when more tables follow
+#define TABLES_MORE 0x80
+
+// Transfer errors (failed status or read) in a row before falling back to a slower transfer speed
+#define TRANSFER_FALLBACK_ERRORS 2
+
+// Server endpoints to choose from (see selectEndpoint), frames to wait on each probe,
+// and failed calls in a row before moving on to the next endpoint
+#define ENDPOINT_MAX 4
+#define ENDPOINT_PROBE_TIMEOUT 120
+#define ENDPOINT_FAILOVER_CALLS 3
+#define ENDPOINT_PROBE_PATH "tables?offset=0&count=0"
+
+// Requests (moves, ready toggles) waiting to be sent ahead of routine state polls, and their max length
+#define REQUEST_QUEUE_MAX 2
+#define REQUEST_PATH_LEN 32
+
+// Single byte reply sent by the server when the state matches the "since" token
+#define API_NOT_MODIFIED (0xFF)
 
 #define STATE_UPDATE_ERROR (0)
 #define STATE_UPDATE_CHANGE (1)
 #define STATE_UPDATE_NOCHANGE (2)
+#define STATE_UPDATE_PENDING (3)
+
+// Poll intervals, in frames
+#define POLL_FAST 20          // Lobby countdown, or right after this player's move
+#define POLL_NORMAL 60        // Waiting on other players
+#define POLL_SLOW 150         // Spectating, defeated, or game over
+#define POLL_JITTER 16        // Random frames added so clients do not poll in lockstep
+#define POLL_ERROR_MAX 960    // Longest wait when backing off after errors
 
 void updateState(bool isTables);
 uint8_t getStateFromServer();
-uint8_t apiCall(const char *path );
-void sendMove(char* move);
+
+/// @brief Makes an Api call, blocking until complete. Returns API_CALL_*
+uint8_t apiCall(const char *path);
+
+/// @brief Starts an Api call without waiting for the reply. Returns API_CALL_PENDING while in flight
+uint8_t apiCallStart(const char *path);
+
+/// @brief Reads the next chunk of the call in flight. Call once per frame until it returns something other than API_CALL_PENDING
+uint8_t apiCallPump();
+
+/// @brief Aborts the call in flight, if any
+void apiCallCancel();
+
+/// @brief Waits for the call in flight (if any) to complete. Returns its API_CALL_* result
+uint8_t apiCallFinish();
+
+/// @brief Returns true while a call is in flight
+bool apiCallBusy();
+
+/// @brief Queues a request (e.g. a move) to be sent ahead of routine state polls.
+/// A state poll in flight is cancelled for it. Returns false if the queue is full
+bool sendMove(const char *move);
+
+/// @brief Sends any call in flight and all queued requests, waiting for each reply
+void flushRequests();
+
+/// @brief Sets state.apiCallWait for the next poll, based on the game phase, or backing off after failedCalls errors
+void schedulePoll(uint8_t update, uint8_t failedCalls);
+
+/// @brief Assembles the parts of the request url that stay the same between calls.
+/// Call after changing serverEndpoint or query. Opening/closing the channel also calls it
+void prepareRequests();
+
+/// @brief Times a request to each server endpoint (the AK_KEY_ENDPOINTS appkey and serverEndpoint),
+/// then switches serverEndpoint to the fastest
+void selectEndpoint();
+
+/// @brief Switches serverEndpoint to the next fastest endpoint. Returns false if there is no other
+bool nextEndpoint();
+
+/// @brief Opens the keep-alive channel to the server endpoint (plain http only). Returns true if open
+bool openChannel();
+
+/// @brief Closes the keep-alive channel, if open
+void closeChannel();
 
 #endif /* STATECLIENT_H */
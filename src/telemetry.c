@@ -0,0 +1,169 @@
+/*******************************************************************
+ *
+ * Do NOT include standard library headers (e.g. conio, std*).
+ * Instead, add to standard_lib.h, which gets included in misc.h
+ *
+ ******************************************************************/
+
+#include "misc.h"
+#include "stateclient.h"
+#include "telemetry.h"
+#include "fujinet-network.h"
+
+#ifdef TELEMETRY
+
+// Platform id sent in each report
+#if defined(__ATARI__)
+#define TELEMETRY_PLATFORM 1
+#elif defined(__C64__)
+#define TELEMETRY_PLATFORM 2
+#elif defined(__APPLE2__)
+#define TELEMETRY_PLATFORM 3
+#elif defined(_CMOC_VERSION_)
+#define TELEMETRY_PLATFORM 4
+#elif defined(__WATCOMC__)
+#define TELEMETRY_PLATFORM 5
+#else
+#define TELEMETRY_PLATFORM 0
+#endif
+
+// Collector devicespec. Uses its own network unit, so the keep-alive channel stays open
+static char collector[70];
+static uint8_t report[TELEMETRY_REPORT_LEN];
+static uint16_t session, sequence, mark;
+
+// Totals since the last report
+static struct
+{
+    uint16_t polls, longPolls, failed, unchanged;
+    uint16_t rttMin, rttMax, bytesMax, missedFrames;
+    uint16_t renders, renderTotal, renderMax;
+    uint32_t rttTotal, bytesTotal;
+} totals;
+
+void telemetryInit()
+{
+    strcpy(collector, "n3:");
+    if (!read_appkey(AK_CREATOR_ID, AK_APP_ID, AK_KEY_TELEMETRY, collector + 3))
+        collector[0] = 0;
+
+    session = getTime() ^ (getRandomNumber(255) << 8 | getRandomNumber(255));
+    totals.rttMin = 0xFFFF;
+}
+
+void telemetryMark()
+{
+#ifndef NO_FRAME_TIME
+    mark = getTime();
+#endif
+}
+
+void telemetryFrames()
+{
+#ifndef NO_FRAME_TIME
+    // Input is read after the next vsync, so any jiffy spent here is a frame missed
+    totals.missedFrames += getTime() - mark;
+#endif
+}
+
+void telemetryRender()
+{
+    static uint16_t t;
+
+    totals.renders++;
+#ifndef NO_FRAME_TIME
+    t = getTime() - mark;
+    totals.renderTotal += t;
+    if (t > totals.renderMax)
+        totals.renderMax = t;
+#endif
+}
+
+/// @brief Stores value little endian in the report
+void putReport16(uint8_t pos, uint16_t value)
+{
+    report[pos] = (uint8_t)value;
+    report[pos + 1] = (uint8_t)(value >> 8);
+}
+
+void putReport32(uint8_t pos, uint32_t value)
+{
+    putReport16(pos, (uint16_t)value);
+    putReport16(pos + 2, (uint16_t)(value >> 16));
+}
+
+/// @brief Posts the totals to the collector and starts over
+void sendReport()
+{
+    static uint16_t bw;
+    static uint8_t conn, err;
+
+    report[0] = TELEMETRY_VERSION;
+    report[1] = TELEMETRY_PLATFORM;
+    putReport16(2, session);
+    putReport16(4, sequence++);
+    putReport16(6, totals.polls);
+    putReport16(8, totals.longPolls);
+    putReport16(10, totals.failed);
+    putReport16(12, totals.unchanged);
+    putReport16(14, totals.rttMin == 0xFFFF ? 0 : totals.rttMin);
+    putReport16(16, totals.rttMax);
+    putReport32(18, totals.rttTotal);
+    putReport32(22, totals.bytesTotal);
+    putReport16(26, totals.bytesMax);
+    putReport16(28, totals.missedFrames);
+    putReport16(30, totals.renders);
+    putReport16(32, totals.renderTotal);
+    putReport16(34, totals.renderMax);
+    report[36] = getJiffiesPerSecond();
+    report[37] = getTransferKbps();
+    strncpy((char *)report + 38, playerName, 8);
+
+    // The request is made once the status is asked for. The reply is not needed
+    if (!network_open(collector, OPEN_MODE_HTTP_POST, OPEN_TRANS_NONE))
+    {
+        network_http_post_bin(collector, report, TELEMETRY_REPORT_LEN);
+        network_status(collector, &bw, &conn, &err);
+        network_close(collector);
+    }
+
+    memset(&totals, 0, sizeof(totals));
+    totals.rttMin = 0xFFFF;
+}
+
+void telemetryPoll(uint8_t result, uint16_t bytes, uint16_t frames, bool longPoll)
+{
+    if (!collector[0])
+        return;
+
+    totals.polls++;
+    if (result == API_CALL_ERROR)
+        totals.failed++;
+    else if (result == API_CALL_NOCHANGE)
+        totals.unchanged++;
+
+    // A held poll lasts until the state changes, so it says nothing about the round trip.
+    // A long poll answered before it could have been held still does
+    if (longPoll && frames > POLL_NORMAL)
+    {
+        totals.longPolls++;
+    }
+    else
+    {
+        totals.rttTotal += frames;
+        if (frames < totals.rttMin)
+            totals.rttMin = frames;
+        if (frames > totals.rttMax)
+            totals.rttMax = frames;
+    }
+
+    totals.bytesTotal += bytes;
+    if (bytes > totals.bytesMax)
+        totals.bytesMax = bytes;
+
+    // Report between renders, so a new state is never held up by it
+    if (totals.polls >= TELEMETRY_POLLS && result != API_CALL_SUCCESS)
+        sendReport();
+}
+
+#endif /* TELEMETRY */
@@ -0,0 +1,57 @@
+/*******************************************************************
+ *
+ * Do NOT include standard library headers (e.g. conio, std*).
+ * Instead, add to standard_lib.h, which gets included in misc.h
+ *
+ ******************************************************************/
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+// Opt-in performance telemetry. Builds with TELEMETRY defined (make <platform> TELEMETRY=1)
+// collect poll and render timings, and post a report every TELEMETRY_POLLS polls to the
+// collector url in the AK_KEY_TELEMETRY appkey (see support/server/collector.py).
+// Without TELEMETRY the calls below compile to nothing.
+
+// Polls between reports
+#define TELEMETRY_POLLS 100
+
+// Report layout, all values little endian. Times are in jiffies (see getJiffiesPerSecond),
+// except rtt, which counts the frames a poll was pumped for. Platforms where getTime does
+// not count frames (NO_FRAME_TIME in vars.h) report 0 missed frames and render times
+//   0 version          1 platform         2 session id       4 sequence
+//   6 polls            8 held polls      10 failed polls    12 unchanged polls
+//  14 rtt min         16 rtt max         18 rtt total(4)    22 bytes total(4)
+//  26 bytes max       28 missed frames   30 renders         32 render total
+//  34 render max      36 jiffies/second  37 link kbps       38 player name[8]
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_REPORT_LEN 46
+
+#ifdef TELEMETRY
+
+/// @brief Reads the collector url. Telemetry stays off if it is not set
+void telemetryInit();
+
+/// @brief Remembers the current time, for telemetryFrames and telemetryRender
+void telemetryMark();
+
+/// @brief Counts frames overrun by network work since telemetryMark
+void telemetryFrames();
+
+/// @brief Adds the time since telemetryMark to the render time
+void telemetryRender();
+
+/// @brief Adds a completed state poll (API_CALL_*) that took frames to pump. Posts a report when one is due
+void telemetryPoll(uint8_t result, uint16_t bytes, uint16_t frames, bool longPoll);
+
+#else
+
+#define telemetryInit()
+#define telemetryMark()
+#define telemetryFrames()
+#define telemetryRender()
+#define telemetryPoll(result, bytes, frames, longPoll)
+
+#endif /* TELEMETRY */
+
+#endif /* TELEMETRY_H */
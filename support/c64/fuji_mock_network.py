@@ -1,96 +1,216 @@
-import time
+"""
+Mock FujiNet network bridge for testing the C64 build in VICE.
+
+Point drive 11 to the working directory (a VICE file system directory), then run:
+  make c64 VICE=1
+The app saves/reads appkeys in that directory, and calls this bridge for network access
+(see custom_network_call in src/c64/emulator.c):
+
+  vice-out  written by the app: a sequence byte followed by the url
+  vice-in   written by the bridge: the same sequence byte followed by the reply
+
+The reply is written to a temporary file and renamed into place, so the app never reads
+a partial reply. On Linux the bridge waits on inotify, so a request is picked up as soon
+as the app closes vice-out. Elsewhere it checks for one every few milliseconds.
+
+Usage: python3 fuji_mock_network.py [working dir] [--server URL | --canned DIR]
+  --server URL  send requests to URL instead, e.g. a local support/server/standin.py
+  --canned DIR  reply from files instead of the network: DIR/state.bin for state calls,
+                DIR/tables.bin for tables, and so on. Calls without a file get an empty reply
+"""
+
+import argparse
+import ctypes
+import ctypes.util
 import os
-import requests  # pip install requests
-
+import struct
+import time
+import urllib.request
 
-# To test in Vice, point drive 11 to the following directory:
-# Then run: make c64 VICE=1
-# The app will then save/read appkeys from this folder and call this bridge for network access
 workingPath = "/Users/eric/Documents/projects/vice-device"
 
+# inotify events for a file written and closed, or renamed into place
+IN_CLOSE_WRITE = 0x08
+IN_MOVED_TO = 0x80
+INOTIFY_EVENT = struct.Struct("iIII")
+
+# Polling interval where inotify is not available
+POLL_INTERVAL = 0.005
+
 
 def download_url_as_bytes(url):
     """
     Download the content from a given URL and return it as a byte array.
     """
     try:
-        response = requests.get(url, headers = {"User-Agent": "MockFujiNetBridge/1.0","Accept": "application/json"})
-        response.raise_for_status()  # Raise an exception for bad status codes (4xx or 5xx)
-        return response.content
-    except requests.exceptions.RequestException as e:
+        request = urllib.request.Request(url, headers={"User-Agent": "MockFujiNetBridge/1.0"})
+        with urllib.request.urlopen(request, timeout=30) as response:
+            return response.read()
+    except Exception as e:
         print(f"Error downloading URL: {e}")
         return bytes()
-        
+
+
+def canned_reply(url):
+    """
+    Returns the canned reply for the call in url, e.g. DIR/state.bin for .../state?table=...
+    """
+    call = url.split("?")[0].rstrip("/").rsplit("/", 1)[-1]
+    path = os.path.join(args.canned, call + ".bin")
+    if not os.path.exists(path):
+        print(f"No canned reply: {path}")
+        return bytes()
+
+    with open(path, "rb") as file:
+        return file.read()
+
+
+def fetch(url):
+    if args.canned:
+        return canned_reply(url)
+
+    # Swap "scheme://host/" for the local server, keeping the path and query
+    if args.server:
+        parts = url.split("/", 3)
+        url = args.server.rstrip("/") + "/" + (parts[3] if len(parts) > 3 else "")
+
+    return download_url_as_bytes(url)
+
+
 def processWatchFile():
     """
-    Read the command of the watch file and send it as a message via the meshtastic interface.
+    Reads the request in the watch file, fetches the reply and writes it to the out file
     """
+    with open(watchFile, "rb") as file:
+        request = file.read()
+    os.remove(watchFile)
 
-    with open(watchFile, "r", encoding="utf-8") as file:
-        command = file.read().strip().lower()
-        if command.startswith("n:"):
-            command = command[2:]  # remove first two characters ("n:")
-        print(f"Sending: {command}")
+    if len(request) < 2:
+        return
 
-        if os.path.exists(outFile):
-            os.remove(outFile)
+    seq = request[0]
+    command = request[1:].decode("latin-1").strip().lower()
+    if command.startswith("n:"):
+        command = command[2:]  # remove first two characters ("n:")
 
-        payload = download_url_as_bytes(command) 
-        print(f"Received {len(payload)} bytes:")
-        #time.sleep(0.200)  #  simulate delay
-        hexdump(payload)
+    start = time.monotonic()
+    print(f"#{seq} Sending: {command}")
+    payload = fetch(command)
+    print(f"Received {len(payload)} bytes in {(time.monotonic() - start) * 1000:.0f} ms:")
+    hexdump(payload)
 
-        with open(outFile, "wb") as file:
-            file.write(payload)
+    with open(tempFile, "wb") as file:
+        file.write(bytes([seq]) + payload)
+    os.replace(tempFile, outFile)
 
-        if os.path.exists(watchFile):
-            os.remove(watchFile)
 
 def hexdump(data: bytes, width: int = 16):
     for i in range(0, len(data), width):
         chunk = data[i:i+width]
-        
+
         # Hex view
         hex_bytes = " ".join(f"{b:02x}" for b in chunk)
-        
+
         # Pad hex output to align text view
         hex_bytes = hex_bytes.ljust(width * 3)
-        
+
         # Text view (printable ASCII, else '.')
         text = "".join(chr(b) if 32 <= b < 127 else "." for b in chunk)
-        
+
         print(f"{i:08x}  {hex_bytes}  {text}")
 
-print("Mock FujiNet Network Bridge")
-print("-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-")
 
-watchFile = workingPath + "/vice-out"
-outFile = workingPath + "/vice-in"
+def open_inotify(path):
+    """
+    Returns an inotify descriptor watching path, or None if inotify is not available
+    """
+    name = ctypes.util.find_library("c")
+    if not name:
+        return None
+
+    libc = ctypes.CDLL(name, use_errno=True)
+    if not hasattr(libc, "inotify_init"):
+        return None
+
+    fd = libc.inotify_init()
+    if fd < 0:
+        return None
+
+    if libc.inotify_add_watch(fd, path.encode(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0:
+        os.close(fd)
+        return None
 
-prevWatchFileCtime = 0
-waitMinAmount = 0.050
-waitMaxAmount = 0.200
-waitAmount = waitMinAmount
+    return fd
 
+
+def wait_inotify(fd):
+    """
+    Blocks until the watch file has been written and closed
+    """
+    while True:
+        events = os.read(fd, 4096)
+        offset = 0
+        while offset < len(events):
+            wd, mask, cookie, length = INOTIFY_EVENT.unpack_from(events, offset)
+            offset += INOTIFY_EVENT.size
+            name = events[offset:offset + length].rstrip(b"\0").decode()
+            offset += length
+            if name == WATCH_NAME:
+                return
+
+
+def wait_polling():
+    """
+    Waits until the watch file exists and has stopped growing
+    """
+    size = -1
+    while True:
+        time.sleep(POLL_INTERVAL)
+        if not os.path.exists(watchFile):
+            size = -1
+            continue
+
+        newSize = os.path.getsize(watchFile)
+        if newSize > 1 and newSize == size:
+            return
+        size = newSize
+
+
+parser = argparse.ArgumentParser(description="Mock FujiNet network bridge for VICE")
+parser.add_argument("path", nargs="?", default=workingPath, help="VICE drive 11 directory")
+source = parser.add_mutually_exclusive_group()
+source.add_argument("--server", help="send requests to this server instead, e.g. http://127.0.0.1:8080/")
+source.add_argument("--canned", help="reply from DIR/<call>.bin files instead of the network")
+args = parser.parse_args()
+
+WATCH_NAME = "vice-out"
+watchFile = os.path.join(args.path, WATCH_NAME)
+outFile = os.path.join(args.path, "vice-in")
+tempFile = os.path.join(args.path, ".vice-in.tmp")
+
+print("Mock FujiNet Network Bridge")
+print("-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-")
 print(f"Watching: {watchFile}")
+if args.server:
+    print(f"Server: {args.server}")
+if args.canned:
+    print(f"Canned replies: {args.canned}")
+
+inotify = open_inotify(args.path)
+print("Using inotify" if inotify is not None else f"Polling every {POLL_INTERVAL * 1000:.0f} ms")
 
 try:
     while True:
-        if os.path.exists(watchFile) and os.path.getsize(watchFile) > 0 and os.path.getctime(watchFile) != prevWatchFileCtime:
-            try:
-                with open(watchFile, 'a') as f:
-                    writable = f.writable()
-                if writable:
-                    prevWatchFileCtime = os.path.getctime(watchFile)
-                    waitAmount=waitMinAmount
-                    processWatchFile()
-                else:
-                    waitAmount = min(waitAmount + waitMinAmount, waitMaxAmount) 
-            except IOError:
-                time.sleep(waitMinAmount)
-           
-
-        time.sleep(waitMinAmount)  #  waitMinAmount
+        # A request may already be waiting
+        if not (os.path.exists(watchFile) and os.path.getsize(watchFile) > 1):
+            if inotify is not None:
+                wait_inotify(inotify)
+            else:
+                wait_polling()
+
+        try:
+            processWatchFile()
+        except IOError as e:
+            print(f"Error processing request: {e}")
 except KeyboardInterrupt:
     print("Exiting")
-iface.close()
@@ -0,0 +1,151 @@
+"""
+Local collector for client telemetry reports.
+
+Clients built with TELEMETRY defined post a report every TELEMETRY_POLLS polls
+to the url in the e41c0502 appkey (see src/telemetry.h for the layout). Each
+report is printed as it arrives, and a table of totals per machine is printed
+on exit, so slow platforms and links stand out.
+
+Usage: python3 collector.py [port] [csv file]
+Then set the e41c0502 appkey to http://<this machine>:<port>/
+"""
+
+import csv
+import struct
+import sys
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+port = 8090
+csv_path = None
+
+REPORT_VERSION = 1
+REPORT_FORMAT = "<BBHHHHHHHHIIHHHHHBB8s"
+REPORT_LEN = struct.calcsize(REPORT_FORMAT)
+FIELDS = ("version", "platform", "session", "sequence",
+          "polls", "long_polls", "failed", "unchanged",
+          "rtt_min", "rtt_max", "rtt_total", "bytes_total",
+          "bytes_max", "missed_frames", "renders", "render_total",
+          "render_max", "jiffies", "kbps", "player")
+
+PLATFORMS = {1: "atari", 2: "c64", 3: "apple2", 4: "coco", 5: "msdos"}
+
+# Totals per machine, keyed by (address, platform, player)
+machines = {}
+
+
+def parse_report(payload):
+    """
+    Returns the report as a dict, or None if it is not a known report
+    """
+    if len(payload) != REPORT_LEN or payload[0] != REPORT_VERSION:
+        return None
+
+    report = dict(zip(FIELDS, struct.unpack(REPORT_FORMAT, payload)))
+    report["platform"] = PLATFORMS.get(report["platform"], "unknown")
+    report["player"] = report["player"].rstrip(b"\0").decode("ascii", "replace")
+    return report
+
+
+def ms(jiffies, report):
+    """
+    Converts jiffies to milliseconds, using the client's jiffies per second
+    """
+    return jiffies * 1000 // report["jiffies"] if report["jiffies"] else 0
+
+
+def summarize(report):
+    """
+    Returns the derived metrics of a report
+    """
+    timed = report["polls"] - report["long_polls"]
+    return {
+        "rtt_min_ms": ms(report["rtt_min"], report),
+        "rtt_avg_ms": ms(report["rtt_total"] // timed, report) if timed else 0,
+        "rtt_max_ms": ms(report["rtt_max"], report),
+        "bytes_avg": report["bytes_total"] // report["polls"] if report["polls"] else 0,
+        "render_avg_ms": ms(report["render_total"] // report["renders"], report) if report["renders"] else 0,
+        "render_max_ms": ms(report["render_max"], report),
+    }
+
+
+def add_to_machine(address, report):
+    key = (address, report["platform"], report["player"])
+    totals = machines.setdefault(key, {"reports": 0, "polls": 0, "long_polls": 0, "failed": 0,
+                                       "rtt_total": 0, "rtt_min": None, "rtt_max": 0,
+                                       "bytes_total": 0, "missed_frames": 0,
+                                       "renders": 0, "render_total": 0, "render_max": 0,
+                                       "jiffies": report["jiffies"], "kbps": report["kbps"]})
+    totals["reports"] += 1
+    for field in ("polls", "long_polls", "failed", "rtt_total", "bytes_total",
+                  "missed_frames", "renders", "render_total"):
+        totals[field] += report[field]
+    if report["polls"] > report["long_polls"]:
+        totals["rtt_min"] = min(totals["rtt_min"] or report["rtt_min"], report["rtt_min"])
+    totals["rtt_max"] = max(totals["rtt_max"], report["rtt_max"])
+    totals["render_max"] = max(totals["render_max"], report["render_max"])
+    totals["kbps"] = report["kbps"]
+
+
+def print_table():
+    print()
+    print(f"{'platform':8} {'player':8} {'address':15} {'polls':>6} {'fail':>5} "
+          f"{'rtt min/avg/max ms':>19} {'bytes':>6} {'missed':>6} {'render avg/max ms':>18} {'kbps':>5}")
+    for (address, platform, player), totals in sorted(machines.items(), key=lambda m: m[0][1]):
+        summary = summarize(dict(totals, rtt_min=totals["rtt_min"] or 0))
+        print(f"{platform:8} {player:8} {address:15} {totals['polls']:6} {totals['failed']:5} "
+              f"{summary['rtt_min_ms']:5}/{summary['rtt_avg_ms']:6}/{summary['rtt_max_ms']:6} "
+              f"{summary['bytes_avg']:6} {totals['missed_frames']:6} "
+              f"{summary['render_avg_ms']:8}/{summary['render_max_ms']:9} {totals['kbps'] or '-':>5}")
+
+
+class CollectorHandler(BaseHTTPRequestHandler):
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length", 0))
+        report = parse_report(self.rfile.read(length))
+
+        self.send_response(200 if report else 400)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+        if not report:
+            print(f"{self.address_string()} sent an unknown report")
+            return
+
+        address = self.client_address[0]
+        summary = summarize(report)
+        add_to_machine(address, report)
+
+        print(f"{time.strftime('%H:%M:%S')} {report['platform']:8} {report['player']:8} "
+              f"#{report['sequence']:<4} polls {report['polls']} failed {report['failed']} "
+              f"rtt {summary['rtt_min_ms']}/{summary['rtt_avg_ms']}/{summary['rtt_max_ms']} ms "
+              f"bytes/poll {summary['bytes_avg']} missed frames {report['missed_frames']} "
+              f"render {summary['render_avg_ms']}/{summary['render_max_ms']} ms")
+
+        if csv_path:
+            with open(csv_path, "a", newline="") as f:
+                writer = csv.writer(f)
+                if f.tell() == 0:
+                    writer.writerow(("time", "address") + FIELDS)
+                writer.writerow((int(time.time()), address) + tuple(report[field] for field in FIELDS))
+
+    def log_message(self, format, *args):
+        pass
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        port = int(sys.argv[1])
+    if len(sys.argv) > 2:
+        csv_path = sys.argv[2]
+
+    print("Fuji Battleship Telemetry Collector")
+    print("-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-")
+    print(f"Listening on port {port}")
+
+    try:
+        ThreadingHTTPServer(("", port), CollectorHandler).serve_forever()
+    except KeyboardInterrupt:
+        print_table()
+        print("Exiting")
@@ -0,0 +1,310 @@
+"""
+Local stand-in for the Fuji Battleship server.
+
+Forwards client api calls to the real server and layers optional protocol
+extensions on top, so clients can use them without any server changes:
+
+  state?...&since=TOKEN   Replies with the single byte 0xFF if the state token
+                          (see state_token below) still matches TOKEN
+  state?...&wait=SECONDS  With since, holds the request open until the state
+                          changes or SECONDS pass (capped at MAX_WAIT)
+  tables?offset=N&count=N Replies with one page of the table list. Bit 7 of the
+                          count byte is set if more tables follow
+  tables?...&since=TOKEN  Replies with the single byte 0xFF if the page is unchanged
+  v=3                     Packs the player records of game replies (see
+                          encode_compact below). Upstream is asked for v=2
+  state?...&view=1        For spectators, with since. While a game is in play,
+                          replies with only the board changes (see view_delta)
+
+Connections are kept alive (HTTP/1.1), so clients can send every request over
+one socket instead of connecting per request.
+
+Usage: python3 standin.py [upstream url] [port]
+Then set the first byte of the e41c0500 appkey to 0xff so the client uses
+http://127.0.0.1:8080/ (see loadPrefs in src/misc.c)
+"""
+
+import sys
+import threading
+import time
+import urllib.request
+import urllib.parse
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+upstream = "https://battleship.carr-designs.com/"
+port = 8080
+
+NOT_MODIFIED = bytes([0xFF])
+
+# Offset of moveTime in the state header. It is skipped by the token, as it
+# ticks down every second without changing anything on the board
+MOVETIME_OFFSET = 37
+
+# Compact (v=3) game replies, see encode_compact
+GAME_HEADER_LEN = 49
+STATUS_OFFSET = 34
+STATUS_LOBBY = 0
+PLAYER_LEN = 115
+COMPACT_FLAG = 0x40
+COMPACT_RLE = 0x80
+
+# Spectator replies, see view_delta
+HEADER_LEN = 39
+PROMPT_LEN = 33
+STATUS_GAMESTART = 10
+STATUS_GAMEOVER = 99
+VIEW_DELTA = 0x20
+VIEW_POLL = 12      # Suggested spectator poll interval, in quarter seconds
+VIEW_STATES = 64    # Recent states kept to diff spectator polls against
+
+# Full states sent, by the token the client will send back as since
+view_states = {}
+view_lock = threading.Lock()
+
+# Table list paging
+TABLE_LEN = 36
+TABLES_MORE = 0x80
+
+# Long poll limits, in seconds
+MAX_WAIT = 30
+WAIT_INTERVAL = 0.5
+
+
+def state_token(payload, skip=MOVETIME_OFFSET):
+    """
+    Fletcher-16 style token over the payload, matching calcStateToken in src/stateclient.c.
+    Pass skip=None for table lists, which have no moveTime
+    """
+    sum1 = sum2 = 0
+    for i, b in enumerate(payload):
+        if i == skip:
+            continue
+        sum1 = (sum1 + b) & 0xFF
+        sum2 = (sum2 + sum1) & 0xFF
+    return sum2 << 8 | sum1
+
+
+def encode_compact(payload):
+    """
+    Re-encodes a v2 game reply with compact player records, matching
+    expandCompactState in src/stateclient.c. Each record is name[9] status(1)
+    mask(1) gamefield, where mask bits 0-4 are shipsLeft and bit 7 marks a
+    run-length encoded gamefield. The gamefield is packed 2 bits per cell, low
+    bits first. When run-length encoded, a 0 byte is followed by the count of 0
+    bytes in the run. Replies that can not be packed are returned unchanged.
+    """
+    if len(payload) <= GAME_HEADER_LEN or payload[STATUS_OFFSET] == STATUS_LOBBY:
+        return payload
+
+    records = payload[GAME_HEADER_LEN:]
+    if len(records) % PLAYER_LEN:
+        return payload
+
+    out = bytearray(payload[:GAME_HEADER_LEN])
+    out[0] |= COMPACT_FLAG
+
+    for r in range(0, len(records), PLAYER_LEN):
+        record = records[r:r + PLAYER_LEN]
+        field = record[10:110]
+        ships = record[110:115]
+        if max(field) > 3 or max(ships) > 1:
+            return payload
+
+        packed = bytes(field[i] | field[i + 1] << 2 | field[i + 2] << 4 | field[i + 3] << 6
+                       for i in range(0, 100, 4))
+
+        rle = bytearray()
+        i = 0
+        while i < len(packed):
+            if packed[i]:
+                rle.append(packed[i])
+                i += 1
+                continue
+            run = 1
+            while i + run < len(packed) and not packed[i + run]:
+                run += 1
+            rle += bytes([0, run])
+            i += run
+
+        mask = sum(ships[j] << j for j in range(5))
+        if len(rle) < len(packed):
+            mask |= COMPACT_RLE
+            packed = rle
+
+        out += record[:10] + bytes([mask]) + packed
+
+    return bytes(out)
+
+
+def view_delta(base, payload):
+    """
+    Returns the changes from base to payload for a spectator, matching applyViewDelta in
+    src/stateclient.c, or None if the full state is needed. The reply is the state header
+    with the changes in place of the prompt (not shown during play): the suggested poll
+    interval, then per player status, ship mask and count, followed by count (pos, value) pairs.
+    """
+    if base is None or len(base) != len(payload) or len(payload) <= GAME_HEADER_LEN:
+        return None
+
+    # Full states carry the prompt, and the winner's ships at game over
+    if payload[0] != base[0] or base[STATUS_OFFSET] < STATUS_GAMESTART or \
+            not STATUS_GAMESTART < payload[STATUS_OFFSET] < STATUS_GAMEOVER:
+        return None
+
+    body = bytearray([VIEW_POLL])
+    for r in range(GAME_HEADER_LEN, len(payload), PLAYER_LEN):
+        old = base[r:r + PLAYER_LEN]
+        new = payload[r:r + PLAYER_LEN]
+        if old[:9] != new[:9]:
+            return None
+
+        changes = [(i, new[10 + i]) for i in range(100) if new[10 + i] != old[10 + i]]
+        body += bytes([new[9], sum((new[110 + j] & 1) << j for j in range(5)), len(changes)])
+        for pos, value in changes:
+            body += bytes([pos, value])
+
+    if len(body) > PROMPT_LEN:
+        return None
+
+    out = bytearray(payload[:HEADER_LEN])
+    out[0] |= VIEW_DELTA
+    out[1:1 + PROMPT_LEN] = body + bytes(PROMPT_LEN - len(body))
+    return bytes(out)
+
+
+def same_state(a, b):
+    """
+    True if two game replies match, apart from moveTime
+    """
+    return len(a) == len(b) and a[:MOVETIME_OFFSET] == b[:MOVETIME_OFFSET] and \
+        a[MOVETIME_OFFSET + 1:] == b[MOVETIME_OFFSET + 1:]
+
+
+def remember_view_state(reply, payload):
+    """
+    Keeps the full state behind a spectator reply, under the token the client will take from it
+    """
+    with view_lock:
+        view_states[state_token(reply)] = payload
+        while len(view_states) > VIEW_STATES:
+            del view_states[next(iter(view_states))]
+
+
+def page_tables(payload, offset, count):
+    """
+    Cuts a page out of the table list, setting TABLES_MORE in the count if more tables follow
+    """
+    rows = [payload[i:i + TABLE_LEN] for i in range(1, 1 + payload[0] * TABLE_LEN, TABLE_LEN)]
+    page = rows[offset:offset + count]
+    more = TABLES_MORE if offset + count < len(rows) else 0
+    return bytes([len(page) | more]) + b"".join(page)
+
+
+def fetch_upstream(path, params):
+    """
+    Forward the request to the real server and return the payload bytes
+    """
+    url = upstream + path.lstrip("/")
+    if params:
+        url += "?" + urllib.parse.urlencode(params)
+
+    request = urllib.request.Request(url, headers={"User-Agent": "BattleshipStandIn/1.0"})
+    with urllib.request.urlopen(request, timeout=10) as response:
+        return response.read()
+
+
+class StandInHandler(BaseHTTPRequestHandler):
+
+    # Keep connections open, so clients can send every request over one socket
+    protocol_version = "HTTP/1.1"
+
+    def do_GET(self):
+        parsed = urllib.parse.urlparse(self.path)
+        path = parsed.path
+        params = dict(urllib.parse.parse_qsl(parsed.query, keep_blank_values=True))
+
+        since = params.pop("since", None)
+        wait = min(float(params.pop("wait", 0) or 0), MAX_WAIT)
+        deadline = time.monotonic() + wait
+
+        compact = params.get("v") == "3"
+        if compact:
+            params["v"] = "2"
+
+        offset = int(params.pop("offset", 0) or 0)
+        count = params.pop("count", None)
+
+        base = None
+        view = params.pop("view", None) == "1" and since is not None
+        if view:
+            with view_lock:
+                base = view_states.get(int(since, 16))
+
+        while True:
+            try:
+                payload = fetch_upstream(path, params)
+            except Exception as e:
+                print(f"Upstream error: {e}")
+                self.send_error(502)
+                return
+
+            if path == "/tables":
+                if count is not None:
+                    payload = page_tables(payload, offset, int(count))
+                if since is not None and state_token(payload, None) == int(since, 16):
+                    payload = NOT_MODIFIED
+                break
+
+            if path != "/state" or since is None:
+                break
+
+            if not (same_state(base, payload) if base is not None else state_token(payload) == int(since, 16)):
+                break
+
+            # Unchanged - keep checking upstream until the wait is over
+            if time.monotonic() + WAIT_INTERVAL > deadline:
+                payload = NOT_MODIFIED
+                break
+            time.sleep(WAIT_INTERVAL)
+
+        if view and path == "/state" and payload != NOT_MODIFIED:
+            delta = view_delta(base, payload)
+            remember_view_state(delta or payload, payload)
+            if delta:
+                self.reply(delta)
+                return
+
+        if compact and path != "/tables" and payload != NOT_MODIFIED:
+            payload = encode_compact(payload)
+
+        self.reply(payload)
+
+    def reply(self, payload):
+        # Keep headers to a minimum, since slow clients read every byte
+        self.log_request(200)
+        self.send_response_only(200)
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+    def log_message(self, format, *args):
+        print(f"{self.address_string()} {format % args}")
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 1:
+        upstream = sys.argv[1]
+        if not upstream.endswith("/"):
+            upstream += "/"
+    if len(sys.argv) > 2:
+        port = int(sys.argv[2])
+
+    print("Fuji Battleship Stand-In Server")
+    print("-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-=-")
+    print(f"Upstream: {upstream}")
+    print(f"Listening on port {port}")
+
+    try:
+        ThreadingHTTPServer(("", port), StandInHandler).serve_forever()
+    except KeyboardInterrupt:
+        print("Exiting")